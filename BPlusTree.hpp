@@ -0,0 +1,316 @@
+#ifndef B_PLUS_TREE_H
+#define B_PLUS_TREE_H
+
+#include "OrderedContainer.hpp"
+#include "SimdSearch.hpp"
+
+#include <new>
+#include <vector>
+
+using std::vector;
+
+/**
+ * A B+-tree whose nodes are cache-line aligned, with each node's keys, count and kind packed into its
+ * first cache line, so that the SIMD search within a node reads a single line. Leaf links and child
+ * pointers follow in the next line(s). Elements are kept in the leaves, which are linked in order to
+ * support range queries.
+ * Nodes are not merged on removal; a node is freed once it becomes empty.
+ *
+ * @tparam U is the type of element stored in the tree
+ */
+template<class U>
+class BPlusTree : public OrderedContainer<U> {
+    // Space left for keys in the first cache line of a node, after its count and kind
+    static const unsigned KEY_BYTES = CACHE_LINE_SIZE - sizeof(unsigned) - sizeof(bool);
+    // Number of keys per node (at least 4 so that splits always leave both halves non-empty)
+    static const unsigned K = KEY_BYTES / sizeof(U) < 4 ? 4 : KEY_BYTES / sizeof(U);
+
+    struct alignas(CACHE_LINE_SIZE) node {
+        U keys[K];
+        unsigned count;
+        bool isLeaf;
+    };
+
+    // Leaf nodes hold elements and are doubly linked in ascending order
+    struct leaf : node {
+        leaf *prev;
+        leaf *next;
+    };
+
+    // Child `i` of an inner node holds the elements between `keys[i - 1]` (inclusive) and `keys[i]`
+    struct inner : node {
+        node *children[K + 1];
+    };
+
+    // Allocated on the first insertion, so that empty trees (e.g. unused buckets) cost no memory
+    node *root = nullptr;
+
+    template<class V>
+    static V *allocate() {
+        return new(allocateAligned(sizeof(V))) V();
+    }
+
+    template<class V>
+    static void deallocate(V *t) {
+        t->~V();
+        freeAligned(t);
+    }
+
+    static leaf *createLeaf() {
+        leaf *t = allocate<leaf>();
+        t->isLeaf = true;
+        return t;
+    }
+
+    static inner *createInner() {
+        inner *t = allocate<inner>();
+        t->isLeaf = false;
+        return t;
+    }
+
+    static void destroy(node *t) {
+        if (t->isLeaf) {
+            deallocate(static_cast<leaf *>(t));
+        } else {
+            deallocate(static_cast<inner *>(t));
+        }
+    }
+
+    static void cleanup(node *t) {
+        if (!t) return;
+        if (!t->isLeaf) {
+            auto in = static_cast<inner *>(t);
+            for (unsigned i = 0; i <= in->count; i++) {
+                cleanup(in->children[i]);
+            }
+        }
+        destroy(t);
+    }
+
+    // Descend to the leaf which would contain `x`
+    const leaf *findLeaf(U x) const {
+        const node *t = root;
+        while (!t->isLeaf) {
+            // Keys equal to a separator belong to the right-hand child
+            auto in = static_cast<const inner *>(t);
+            t = in->children[in->count - countGreater(in->keys, in->count, x)];
+        }
+        return static_cast<const leaf *>(t);
+    }
+
+    bool insert(U x, node *t, U &splitKey, node *&split) {
+        if (t->isLeaf) {
+            auto lf = static_cast<leaf *>(t);
+            unsigned i = countLess(lf->keys, lf->count, x);
+            if (i < lf->count && lf->keys[i] == x) {
+                return false;
+            }
+            if (lf->count < K) {
+                insertAt(lf->keys, lf->count, i, x);
+                lf->count++;
+                return true;
+            }
+
+            // Split a full leaf, moving the upper half into a new right-hand sibling
+            U keys[K + 1];
+            copy(lf->keys, lf->keys + K, keys);
+            insertAt(keys, K, i, x);
+            leaf *right = createLeaf();
+            unsigned mid = (K + 1) / 2;
+            lf->count = mid;
+            right->count = K + 1 - mid;
+            copy(keys, keys + mid, lf->keys);
+            copy(keys + mid, keys + K + 1, right->keys);
+            right->prev = lf;
+            right->next = lf->next;
+            if (lf->next) {
+                lf->next->prev = right;
+            }
+            lf->next = right;
+            splitKey = right->keys[0];
+            split = right;
+            return true;
+        }
+
+        auto in = static_cast<inner *>(t);
+        unsigned i = in->count - countGreater(in->keys, in->count, x);
+        U childKey;
+        node *child = nullptr;
+        if (!insert(x, in->children[i], childKey, child)) {
+            return false;
+        }
+        if (!child) {
+            return true;
+        }
+        if (in->count < K) {
+            insertAt(in->keys, in->count, i, childKey);
+            insertAt(in->children, in->count + 1, i + 1, child);
+            in->count++;
+            return true;
+        }
+
+        // Split a full inner node, promoting the middle key to the parent
+        U keys[K + 1];
+        node *children[K + 2];
+        copy(in->keys, in->keys + K, keys);
+        copy(in->children, in->children + K + 1, children);
+        insertAt(keys, K, i, childKey);
+        insertAt(children, K + 1, i + 1, child);
+        inner *right = createInner();
+        unsigned mid = (K + 1) / 2;
+        in->count = mid;
+        right->count = K - mid;
+        copy(keys, keys + mid, in->keys);
+        copy(children, children + mid + 1, in->children);
+        copy(keys + mid + 1, keys + K + 1, right->keys);
+        copy(children + mid + 1, children + K + 2, right->children);
+        splitKey = keys[mid];
+        split = right;
+        return true;
+    }
+
+    // Returns true if `x` was removed; sets `empty` if the node no longer holds any elements
+    bool remove(U x, node *t, bool &empty) {
+        if (t->isLeaf) {
+            auto lf = static_cast<leaf *>(t);
+            unsigned i = countLess(lf->keys, lf->count, x);
+            if (i >= lf->count || !(lf->keys[i] == x)) {
+                return false;
+            }
+            eraseAt(lf->keys, lf->count, i);
+            lf->count--;
+            empty = !lf->count;
+            return true;
+        }
+
+        auto in = static_cast<inner *>(t);
+        unsigned i = in->count - countGreater(in->keys, in->count, x);
+        bool childEmpty = false;
+        if (!remove(x, in->children[i], childEmpty)) {
+            return false;
+        }
+        if (childEmpty) {
+            node *child = in->children[i];
+            if (child->isLeaf) {
+                // Unlink the empty leaf from its neighbors
+                auto lf = static_cast<leaf *>(child);
+                if (lf->prev) lf->prev->next = lf->next;
+                if (lf->next) lf->next->prev = lf->prev;
+            }
+            destroy(child);
+            if (!in->count) {
+                // The removed child was the only one left
+                empty = true;
+                return true;
+            }
+            // Drop the separator bordering the removed child; its neighbor absorbs the empty range
+            eraseAt(in->keys, in->count, i ? i - 1 : 0);
+            eraseAt(in->children, in->count + 1, i);
+            in->count--;
+        }
+        return true;
+    }
+
+    template<class V>
+    static void copy(const V *first, const V *last, V *out) {
+        while (first != last) {
+            *out++ = *first++;
+        }
+    }
+
+    // Insert `value` at `index` of an array currently holding `size` entries
+    template<class V>
+    static void insertAt(V *array, unsigned size, unsigned index, V value) {
+        for (unsigned j = size; j > index; j--) {
+            array[j] = array[j - 1];
+        }
+        array[index] = value;
+    }
+
+    // Erase the entry at `index` of an array currently holding `size` entries
+    template<class V>
+    static void eraseAt(V *array, unsigned size, unsigned index) {
+        for (unsigned j = index; j + 1 < size; j++) {
+            array[j] = array[j + 1];
+        }
+    }
+
+public:
+    explicit BPlusTree() {
+    }
+
+    BPlusTree(const BPlusTree &) = delete;
+
+    BPlusTree &operator=(const BPlusTree &) = delete;
+
+    ~BPlusTree() {
+        cleanup(root);
+    }
+
+    bool contains(U x) const override {
+        if (!root) return false;
+        const leaf *lf = findLeaf(x);
+        unsigned i = countLess(lf->keys, lf->count, x);
+        return i < lf->count && lf->keys[i] == x;
+    }
+
+    bool insert(U x) override {
+        if (!root) {
+            root = createLeaf();
+        }
+        U splitKey;
+        node *split = nullptr;
+        if (!insert(x, root, splitKey, split)) {
+            return false;
+        }
+        if (split) {
+            // Grow the tree by one level
+            inner *top = createInner();
+            top->count = 1;
+            top->keys[0] = splitKey;
+            top->children[0] = root;
+            top->children[1] = split;
+            root = top;
+        }
+        return true;
+    }
+
+    bool remove(U x) override {
+        if (!root) return false;
+        bool empty = false;
+        if (!remove(x, root, empty)) {
+            return false;
+        }
+        if (empty) {
+            // Every element has been removed, and all nodes below the root have already been freed
+            destroy(root);
+            root = nullptr;
+        } else {
+            // Shrink the tree while the root has a single child
+            while (!root->isLeaf && !root->count) {
+                node *child = static_cast<inner *>(root)->children[0];
+                destroy(root);
+                root = child;
+            }
+        }
+        return true;
+    }
+
+    vector<U> range(U low, U high) const override {
+        vector<U> result;
+        if (!root) return result;
+        const leaf *lf = findLeaf(low);
+        unsigned i = countLess(lf->keys, lf->count, low);
+        for (; lf; lf = lf->next, i = 0) {
+            for (; i < lf->count; i++) {
+                if (high < lf->keys[i]) {
+                    return result;
+                }
+                result.push_back(lf->keys[i]);
+            }
+        }
+        return result;
+    }
+};
+
+#endif
@@ -1,7 +1,7 @@
 #ifndef AVL_TREE_H
 #define AVL_TREE_H
 
-#include "Container.hpp"
+#include "OrderedContainer.hpp"
 
 #include <set>
 
@@ -11,7 +11,7 @@
  * @tparam U is the type of element stored in the tree
  */
 template<class U>
-class BalancedTree : public Container<U> {
+class BalancedTree : public OrderedContainer<U> {
     std::set<U> tree;
 
 public:
@@ -30,6 +30,13 @@ public:
         tree.erase(x);
         return tree.size() != prevSize;
     }
+
+    vector<U> range(U low, U high) const override {
+        if (high < low) {
+            return vector<U>();
+        }
+        return vector<U>(tree.lower_bound(low), tree.upper_bound(high));
+    }
 };
 
 #endif
\ No newline at end of file
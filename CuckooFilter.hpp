@@ -0,0 +1,273 @@
+#ifndef CUCKOO_FILTER_H
+#define CUCKOO_FILTER_H
+
+#include "Container.hpp"
+#include "SimdSearch.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+
+/**
+ * An approximate-membership filter which stores a 15-bit fingerprint per element. `contains` may
+ * return false positives but never false negatives, as long as only inserted elements are removed.
+ *
+ * Both candidate buckets of an element lie in the same cache-line-sized block, so every lookup
+ * touches a single cache line. Elements which cannot be placed in their block go to a small,
+ * fixed-size overflow area of that block, and the spare bit of each bucket's first slot flags
+ * whether the overflow area needs to be searched. Should the overflow area fill up as well (only
+ * when the filter is filled well past its expected size), the block is marked saturated and
+ * reports every lookup as a possible match.
+ *
+ * @tparam U is the type of element tracked by the filter
+ */
+template<class U>
+class CuckooFilter : public Container<U> {
+    static const unsigned SLOTS = 4;
+    static const unsigned BUCKETS = CACHE_LINE_SIZE / (SLOTS * sizeof(uint16_t));
+    static const unsigned MAX_KICKS = 32;
+    static const unsigned OVERFLOW_SLOTS = 3;
+    static const uint16_t FINGERPRINT_MASK = 0x7fff;
+    static const uint16_t OVERFLOW_FLAG = 0x8000;
+
+    struct block {
+        uint16_t buckets[BUCKETS][SLOTS];
+    };
+
+    // Fingerprints which did not fit into a block, each stored with its bucket as `bucket << 16 | fingerprint`
+    struct overflowArea {
+        uint32_t entries[OVERFLOW_SLOTS];
+        uint32_t saturated;
+    };
+
+    block *blocks;
+    unsigned blockCount;
+    // Overflow areas of the blocks which need one, only read for buckets whose overflow flag is set
+    std::unordered_map<unsigned, overflowArea> overflow;
+    // State for choosing which fingerprint to evict
+    uint32_t random = 2463534242u;
+
+    // Compute the block index, primary bucket, and non-zero fingerprint for an element
+    void locate(U x, unsigned &blockIndex, unsigned &bucket, uint16_t &fingerprint) const {
+        // Mix the standard hash (the identity for integers) with the splitmix64 finalizer
+        uint64_t h = std::hash<U>()(x);
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+        h ^= h >> 31;
+        blockIndex = (unsigned) ((h >> 32) % blockCount);
+        bucket = (unsigned) (h >> 16) % BUCKETS;
+        fingerprint = (uint16_t) (h & FINGERPRINT_MASK) ? (uint16_t) (h & FINGERPRINT_MASK) : 1;
+    }
+
+    // The alternate bucket of a fingerprint, which is always a different bucket of the same block
+    static unsigned alternate(unsigned bucket, uint16_t fingerprint) {
+        return bucket ^ (1 + fingerprint % (BUCKETS - 1));
+    }
+
+    static bool has(const uint16_t *bucket, uint16_t fingerprint) {
+        bool found = false;
+        for (unsigned i = 0; i < SLOTS; i++) {
+            found |= (bucket[i] & FINGERPRINT_MASK) == fingerprint;
+        }
+        return found;
+    }
+
+    static uint32_t entry(unsigned bucket, uint16_t fingerprint) {
+        return (uint32_t) bucket << 16 | fingerprint;
+    }
+
+    static bool place(uint16_t *bucket, uint16_t fingerprint) {
+        for (unsigned i = 0; i < SLOTS; i++) {
+            if (!(bucket[i] & FINGERPRINT_MASK)) {
+                bucket[i] |= fingerprint;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool erase(uint16_t *bucket, uint16_t fingerprint) {
+        for (unsigned i = 0; i < SLOTS; i++) {
+            if ((bucket[i] & FINGERPRINT_MASK) == fingerprint) {
+                bucket[i] &= OVERFLOW_FLAG;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t nextRandom() {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        return random;
+    }
+
+public:
+    /**
+     * @param expected is the number of elements the filter is sized for (at about 50% occupancy, since
+     * fuller blocks regularly overflow when alternate buckets are confined to a single block)
+     */
+    explicit CuckooFilter(unsigned expected) {
+        unsigned perBlock = BUCKETS * SLOTS / 2;
+        blockCount = expected / perBlock + 1;
+        blocks = static_cast<block *>(allocateAligned((size_t) blockCount * sizeof(block)));
+        memset(blocks, 0, (size_t) blockCount * sizeof(block));
+    }
+
+    CuckooFilter(const CuckooFilter &) = delete;
+
+    CuckooFilter &operator=(const CuckooFilter &) = delete;
+
+    ~CuckooFilter() {
+        freeAligned(blocks);
+    }
+
+    // Number of fingerprint slots
+    unsigned capacity() const override {
+        return blockCount * BUCKETS * SLOTS;
+    }
+
+    // Number of elements which did not fit into their block
+    unsigned overflowSize() const {
+        unsigned count = 0;
+        for (auto &o : overflow) {
+            for (uint32_t e : o.second.entries) {
+                count += e != 0;
+            }
+        }
+        return count;
+    }
+
+    // Number of blocks whose overflow area ran out of space
+    unsigned saturatedBlocks() const {
+        unsigned count = 0;
+        for (auto &o : overflow) {
+            count += o.second.saturated != 0;
+        }
+        return count;
+    }
+
+    // Number of bytes used by the filter, estimating one pointer of overhead per overflow area
+    unsigned memoryUsage() const {
+        return blockCount * sizeof(block) + overflow.bucket_count() * sizeof(void *)
+               + overflow.size() * (sizeof(unsigned) + sizeof(overflowArea) + sizeof(void *));
+    }
+
+    // Whether a lookup of `x` which misses its buckets has to search the block's overflow area
+    bool overflowing(U x) const {
+        unsigned blockIndex, bucket;
+        uint16_t fingerprint;
+        locate(x, blockIndex, bucket, fingerprint);
+        const block &b = blocks[blockIndex];
+        return (b.buckets[bucket][0] | b.buckets[alternate(bucket, fingerprint)][0]) & OVERFLOW_FLAG;
+    }
+
+    bool contains(U x) const override {
+        unsigned blockIndex, bucket;
+        uint16_t fingerprint;
+        locate(x, blockIndex, bucket, fingerprint);
+        const block &b = blocks[blockIndex];
+        unsigned other = alternate(bucket, fingerprint);
+        if (has(b.buckets[bucket], fingerprint) || has(b.buckets[other], fingerprint)) {
+            return true;
+        }
+        if (!((b.buckets[bucket][0] | b.buckets[other][0]) & OVERFLOW_FLAG)) {
+            return false;
+        }
+        auto o = overflow.find(blockIndex);
+        if (o == overflow.end()) {
+            return false;
+        }
+        if (o->second.saturated) {
+            return true;
+        }
+        for (uint32_t e : o->second.entries) {
+            if (e == entry(bucket, fingerprint) || e == entry(other, fingerprint)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Duplicate elements are stored as separate fingerprints, so each one must be removed separately
+    bool insert(U x) override {
+        unsigned blockIndex, bucket;
+        uint16_t fingerprint;
+        locate(x, blockIndex, bucket, fingerprint);
+        block &b = blocks[blockIndex];
+        if (place(b.buckets[bucket], fingerprint)) {
+            return true;
+        }
+        bucket = alternate(bucket, fingerprint);
+        if (place(b.buckets[bucket], fingerprint)) {
+            return true;
+        }
+
+        // Evict fingerprints into their alternate buckets until a free slot turns up
+        for (unsigned kick = 0; kick < MAX_KICKS; kick++) {
+            uint16_t &slot = b.buckets[bucket][nextRandom() % SLOTS];
+            uint16_t evicted = slot & FINGERPRINT_MASK;
+            slot = (slot & OVERFLOW_FLAG) | fingerprint;
+            fingerprint = evicted;
+            bucket = alternate(bucket, fingerprint);
+            if (place(b.buckets[bucket], fingerprint)) {
+                return true;
+            }
+        }
+        overflowArea &o = overflow[blockIndex];
+        for (uint32_t &e : o.entries) {
+            if (!e) {
+                e = entry(bucket, fingerprint);
+                b.buckets[bucket][0] |= OVERFLOW_FLAG;
+                return true;
+            }
+        }
+        // Drop the fingerprint, and flag every bucket so that lookups in this block always match
+        o.saturated = 1;
+        for (auto &flagged : b.buckets) {
+            flagged[0] |= OVERFLOW_FLAG;
+        }
+        return true;
+    }
+
+    // Only remove elements which have been inserted; otherwise another element's fingerprint may be dropped
+    bool remove(U x) override {
+        unsigned blockIndex, bucket;
+        uint16_t fingerprint;
+        locate(x, blockIndex, bucket, fingerprint);
+        block &b = blocks[blockIndex];
+        unsigned other = alternate(bucket, fingerprint);
+        if (erase(b.buckets[bucket], fingerprint) || erase(b.buckets[other], fingerprint)) {
+            return true;
+        }
+        auto o = overflow.find(blockIndex);
+        if (o == overflow.end()) {
+            return false;
+        }
+        for (uint32_t &e : o->second.entries) {
+            if (e == entry(bucket, fingerprint) || e == entry(other, fingerprint)) {
+                unsigned overflowBucket = e >> 16;
+                e = 0;
+                // Clear the overflow flag once no other overflowing fingerprint belongs to the bucket
+                bool overflowing = o->second.saturated != 0;
+                bool used = overflowing;
+                for (uint32_t f : o->second.entries) {
+                    overflowing |= f && f >> 16 == overflowBucket;
+                    used |= f != 0;
+                }
+                if (!overflowing) {
+                    b.buckets[overflowBucket][0] &= FINGERPRINT_MASK;
+                }
+                if (!used) {
+                    overflow.erase(o);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+#endif
@@ -2,7 +2,9 @@
 #define CUCKOO_TABLE_H
 
 #include "Container.hpp"
+#include "Snapshot.hpp"
 
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <cmath>
@@ -23,12 +25,25 @@ class CuckooTable : public Container<U> {
 protected:
     int tableSize;
     pair<bool, U> *tables[N];
+    // Backing pages when the tables were loaded from a snapshot
+    SnapshotMapping snapshot;
 
     // Compute a hash from the output of `H` given the table index and element, modulo table capacity
     unsigned hash(unsigned n, U item) const {
         return H(n, item, tableSize) % tableSize;
     }
 
+    // Free a set of slot arrays, which are either heap-allocated or part of the snapshot mapping
+    void release(pair<bool, U> *const *slots) {
+        if (snapshot.mapped()) {
+            snapshot.unmap();
+        } else {
+            for (unsigned n = 0; n < N; n++) {
+                delete[] slots[n];
+            }
+        }
+    }
+
 public:
     explicit CuckooTable(int size) {
         tableSize = size;
@@ -37,12 +52,23 @@ public:
         }
     }
 
-    ~CuckooTable() {
-        for (auto table : tables) {
-            delete[] table;
+    // Deep copy, which always allocates heap tables even if `other` was loaded from a snapshot
+    CuckooTable(const CuckooTable &other) : Container<U>(other) {
+        tableSize = other.tableSize;
+        for (unsigned n = 0; n < N; n++) {
+            tables[n] = new pair<bool, U>[tableSize];
+            for (unsigned i = 0; i < (unsigned) tableSize; i++) {
+                tables[n][i] = other.tables[n][i];
+            }
         }
     }
 
+    CuckooTable &operator=(const CuckooTable &) = delete;
+
+    ~CuckooTable() {
+        release(tables);
+    }
+
     unsigned capacity() const override {
         return tableSize;
     }
@@ -69,9 +95,7 @@ public:
             }
         }
         // Clean up previous tables
-        for (auto table : prevTables) {
-            delete[] table;
-        }
+        release(prevTables);
         for (U x : unplaced) {
             // If unable to re-insert again, display a warning
             if (!insert(x)) {
@@ -80,6 +104,48 @@ public:
         }
     }
 
+    // Identifies the indexed hash function by fingerprinting its output on a fixed set of inputs
+    static uint64_t hashId() {
+        uint64_t id = SNAPSHOT_FNV_OFFSET;
+        for (unsigned n = 0; n < N; n++) {
+            for (unsigned i = 0; i < SNAPSHOT_HASH_SAMPLES; i++) {
+                id = snapshotMix(id, H(n, snapshotSample<U>(i), snapshotSampleCapacity(i)));
+            }
+        }
+        return id;
+    }
+
+    // Write all N tables to a position-independent snapshot file
+    void save(const string &path) const {
+        static_assert(std::is_trivially_copyable<U>::value, "Snapshots require trivially copyable elements");
+        SnapshotHeader header{};
+        header.kind = SNAPSHOT_CUCKOO;
+        header.tableCount = N;
+        header.capacity = tableSize;
+        header.slotSize = sizeof(pair<bool, U>);
+        header.hashId = hashId();
+        std::vector<char> images[N];
+        const void *slots[N];
+        for (unsigned n = 0; n < N; n++) {
+            images[n] = snapshotSlots(tables[n], tableSize);
+            slots[n] = images[n].data();
+        }
+        writeSnapshot(path, header, slots);
+    }
+
+    // Replace the table contents with a memory-mapped snapshot, which is read in place without copying
+    void load(const string &path, bool verify = true) {
+        static_assert(std::is_trivially_copyable<U>::value, "Snapshots require trivially copyable elements");
+        SnapshotMapping mapping;
+        mapping.open(path, SNAPSHOT_CUCKOO, N, sizeof(pair<bool, U>), hashId(), verify);
+        release(tables);
+        snapshot.swap(mapping);
+        tableSize = snapshot.header().capacity;
+        for (unsigned n = 0; n < N; n++) {
+            tables[n] = reinterpret_cast<pair<bool, U> *>(snapshot.table(n));
+        }
+    }
+
     bool contains(U item) const override {
         for (unsigned n = 0; n < N; n++) {
             auto i = hash(n, item);
@@ -0,0 +1,30 @@
+#ifndef DATA_SET_H
+#define DATA_SET_H
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Load dataset from a given file name
+inline std::vector<int> loadData(const std::string &filename) {
+    std::vector<int> vec;
+    std::ifstream input(filename);
+    if (!input.is_open()) {
+        throw std::runtime_error("Data file not found; check your current working directory");
+    }
+
+    std::string line, token;
+    while (getline(input, line)) {
+        std::stringstream ss(line);
+        while (getline(ss, token, ',')) {
+            vec.push_back(stoi(token));
+        }
+    }
+
+    input.close();
+    return vec;
+}
+
+#endif
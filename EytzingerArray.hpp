@@ -0,0 +1,112 @@
+#ifndef EYTZINGER_ARRAY_H
+#define EYTZINGER_ARRAY_H
+
+#include "OrderedContainer.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+using std::vector;
+using std::lower_bound;
+using std::upper_bound;
+
+/**
+ * A sorted array stored in Eytzinger (breadth-first binary heap) order, intended for read-mostly data.
+ * Lookups descend the implicit tree without branches, and the next levels are prefetched while the
+ * current one is compared. Updates are applied to a plain sorted array, and the Eytzinger layout is
+ * rebuilt lazily by the next lookup.
+ *
+ * @tparam U is the type of element stored in the array
+ */
+template<class U>
+class EytzingerArray : public OrderedContainer<U> {
+    // Elements in ascending order, used for updates and range queries
+    vector<U> sorted;
+    // Elements in Eytzinger order; index 0 is unused so that the children of `k` are `2k` and `2k + 1`
+    mutable vector<U> layout = vector<U>(1);
+    mutable bool stale = false;
+
+    // Fill the layout with an in-order traversal of the implicit tree rooted at `k`
+    void build(unsigned &i, unsigned k) const {
+        if (k < layout.size()) {
+            build(i, 2 * k);
+            layout[k] = sorted[i++];
+            build(i, 2 * k + 1);
+        }
+    }
+
+    void rebuild() const {
+        layout.resize(sorted.size() + 1);
+        unsigned i = 0;
+        build(i, 1);
+        stale = false;
+    }
+
+public:
+    explicit EytzingerArray() {
+    }
+
+    // Bulk-load a set of elements in a single O(n log n) pass
+    explicit EytzingerArray(vector<U> items) : sorted(std::move(items)) {
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        rebuild();
+    }
+
+    unsigned capacity() const override {
+        return sorted.capacity();
+    }
+
+    bool contains(U x) const override {
+        if (stale) {
+            rebuild();
+        }
+        const U *data = layout.data();
+        unsigned n = layout.size() - 1;
+        unsigned k = 1;
+        while (k <= n) {
+#if defined(__GNUC__)
+            // Prefetch the great-grandchildren; with 4-byte keys these 8 nodes share one cache line
+            __builtin_prefetch(data + 8 * k);
+#endif
+            k = 2 * k + (data[k] < x);
+        }
+        // Undo the trailing right turns plus the final left turn to find the lower bound
+        while (k & 1) {
+            k >>= 1;
+        }
+        k >>= 1;
+        return k && data[k] == x;
+    }
+
+    bool insert(U x) override {
+        auto it = lower_bound(sorted.begin(), sorted.end(), x);
+        if (it != sorted.end() && *it == x) {
+            return false;
+        }
+        sorted.insert(it, x);
+        stale = true;
+        return true;
+    }
+
+    bool remove(U x) override {
+        auto it = lower_bound(sorted.begin(), sorted.end(), x);
+        if (it == sorted.end() || !(*it == x)) {
+            return false;
+        }
+        sorted.erase(it);
+        stale = true;
+        return true;
+    }
+
+    vector<U> range(U low, U high) const override {
+        if (high < low) {
+            return vector<U>();
+        }
+        auto first = lower_bound(sorted.begin(), sorted.end(), low);
+        return vector<U>(first, upper_bound(first, sorted.end(), high));
+    }
+};
+
+#endif
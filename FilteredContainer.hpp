@@ -0,0 +1,55 @@
+#ifndef FILTERED_CONTAINER_H
+#define FILTERED_CONTAINER_H
+
+#include "Container.hpp"
+#include "CuckooFilter.hpp"
+
+/**
+ * A wrapper which places a cuckoo filter in front of another container, so that lookups of absent
+ * elements usually return after reading one cache line of the filter instead of searching the table.
+ *
+ * @tparam U is the type of element stored in the container
+ */
+template<class U>
+class FilteredContainer : public Container<U> {
+    Container<U> &table;
+    CuckooFilter<U> filter;
+
+public:
+    /**
+     * @param table is the wrapped container, which must be empty and outlive the wrapper
+     * @param expected is the number of elements the filter is sized for
+     */
+    FilteredContainer(Container<U> &table, unsigned expected) : table(table), filter(expected) {
+    }
+
+    unsigned capacity() const override {
+        return table.capacity();
+    }
+
+    const CuckooFilter<U> &getFilter() const {
+        return filter;
+    }
+
+    bool contains(U x) const override {
+        return filter.contains(x) && table.contains(x);
+    }
+
+    bool insert(U x) override {
+        if (!table.insert(x)) {
+            return false;
+        }
+        filter.insert(x);
+        return true;
+    }
+
+    bool remove(U x) override {
+        if (!table.remove(x)) {
+            return false;
+        }
+        filter.remove(x);
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef FLAT_BUCKET_H
+#define FLAT_BUCKET_H
+
+#include "Container.hpp"
+#include "SimdSearch.hpp"
+
+#include <vector>
+
+using std::vector;
+
+/**
+ * A hash table bucket which stores its first few elements inline, so that a lookup usually reads a
+ * single cache line and compares every element with a few SIMD instructions. Elements beyond the
+ * inline capacity spill into a heap-allocated overflow vector. Like `SinglyLinkedList`, insertion
+ * does not check for duplicates.
+ *
+ * @tparam U is the type of element stored in the bucket
+ */
+template<class U>
+class alignas(CACHE_LINE_SIZE) FlatBucket : public Container<U> {
+    // Inline slots which fit in one cache line alongside the vtable pointer, count, and overflow pointer
+    static const unsigned K = (CACHE_LINE_SIZE - 2 * sizeof(void *) - sizeof(unsigned)) / sizeof(U) < 1
+                              ? 1 : (CACHE_LINE_SIZE - 2 * sizeof(void *) - sizeof(unsigned)) / sizeof(U);
+
+    U keys[K];
+    unsigned count = 0;
+    vector<U> *overflow = nullptr;
+
+public:
+    explicit FlatBucket() {
+    }
+
+    FlatBucket(const FlatBucket &) = delete;
+
+    FlatBucket &operator=(const FlatBucket &) = delete;
+
+    ~FlatBucket() {
+        delete overflow;
+    }
+
+    bool contains(U x) const override {
+        if (findEqual(keys, count, x) != count) {
+            return true;
+        }
+        return overflow && findEqual(overflow->data(), overflow->size(), x) != overflow->size();
+    }
+
+    bool insert(U x) override {
+        if (count < K) {
+            keys[count++] = x;
+            return true;
+        }
+        if (!overflow) {
+            overflow = new vector<U>();
+        }
+        overflow->push_back(x);
+        return true;
+    }
+
+    bool remove(U x) override {
+        unsigned i = findEqual(keys, count, x);
+        if (i != count) {
+            // Refill the inline slot from the overflow so that inline slots stay contiguous
+            keys[i] = overflow ? popOverflow() : keys[--count];
+            return true;
+        }
+        if (!overflow) {
+            return false;
+        }
+        unsigned size = overflow->size();
+        i = findEqual(overflow->data(), size, x);
+        if (i == size) {
+            return false;
+        }
+        U last = popOverflow();
+        if (i != size - 1) {
+            (*overflow)[i] = last;
+        }
+        return true;
+    }
+
+private:
+    // Remove and return the last overflow element, freeing the overflow vector once it is empty
+    U popOverflow() {
+        U last = overflow->back();
+        overflow->pop_back();
+        if (overflow->empty()) {
+            delete overflow;
+            overflow = nullptr;
+        }
+        return last;
+    }
+};
+
+#endif
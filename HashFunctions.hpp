@@ -0,0 +1,41 @@
+#ifndef HASH_FUNCTIONS_H
+#define HASH_FUNCTIONS_H
+
+#include <stdexcept>
+
+// h(x); modulo is implicitly applied by hash tables
+inline unsigned hash1(int item, unsigned size) {
+    return item;
+}
+
+// h'(x);
+inline unsigned hash2(int item, unsigned size) {
+    return item / size;
+}
+
+// h*(x); added for 3-table cuckoo hashing
+inline unsigned hash3(int item, unsigned size) {
+    return (item | (3 << 10)); // NOLINT(hicpp-signed-bitwise)
+}
+
+// h**(x); added for 4-table cuckoo hashing
+inline unsigned hash4(int item, unsigned size) {
+    return (item | (3 << 8)); // NOLINT(hicpp-signed-bitwise)
+}
+
+// Conditional hashing based on table index
+inline unsigned multiHash(unsigned n, int item, unsigned size) {
+    switch (n + 1) {
+        case 1:
+            return hash1(item, size);
+        case 2:
+            return hash2(item, size);
+        case 3:
+            return hash3(item, size);
+        case 4:
+            return hash4(item, size);
+    }
+    throw std::runtime_error("Unexpected hash function index");
+}
+
+#endif
@@ -2,7 +2,9 @@
 #define LINEAR_HASH_TABLE_H
 
 #include "HashTable.hpp"
+#include "Snapshot.hpp"
 
+#include <type_traits>
 #include <utility>
 
 using std::pair;
@@ -18,6 +20,17 @@ class LinearHashTable : public HashTable<U, H> {
 protected:
     int tableSize;
     pair<bool, U> *table;
+    // Backing pages when the table was loaded from a snapshot
+    SnapshotMapping snapshot;
+
+    // Free a slot array, which is either heap-allocated or part of the snapshot mapping
+    void release(pair<bool, U> *slots) {
+        if (snapshot.mapped()) {
+            snapshot.unmap();
+        } else {
+            delete[] slots;
+        }
+    }
 
 public:
     explicit LinearHashTable(unsigned size) {
@@ -25,8 +38,19 @@ public:
         table = new pair<bool, U>[size];
     }
 
+    // Deep copy, which always allocates a heap table even if `other` was loaded from a snapshot
+    LinearHashTable(const LinearHashTable &other) : HashTable<U, H>(other) {
+        tableSize = other.tableSize;
+        table = new pair<bool, U>[tableSize];
+        for (unsigned i = 0; i < (unsigned) tableSize; i++) {
+            table[i] = other.table[i];
+        }
+    }
+
+    LinearHashTable &operator=(const LinearHashTable &) = delete;
+
     ~LinearHashTable() {
-        delete[] table;
+        release(table);
     }
 
     unsigned capacity() const override {
@@ -43,7 +67,41 @@ public:
                 cout << "Warning: could not re-insert value into resized table" << endl;
             }
         }
-        delete[] prevTable;
+        release(prevTable);
+    }
+
+    // Identifies the hash function by fingerprinting its output on a fixed set of inputs
+    static uint64_t hashId() {
+        uint64_t id = SNAPSHOT_FNV_OFFSET;
+        for (unsigned i = 0; i < SNAPSHOT_HASH_SAMPLES; i++) {
+            id = snapshotMix(id, H(snapshotSample<U>(i), snapshotSampleCapacity(i)));
+        }
+        return id;
+    }
+
+    // Write the table slots to a position-independent snapshot file
+    void save(const string &path) const {
+        static_assert(std::is_trivially_copyable<U>::value, "Snapshots require trivially copyable elements");
+        SnapshotHeader header{};
+        header.kind = SNAPSHOT_LINEAR_PROBING;
+        header.tableCount = 1;
+        header.capacity = tableSize;
+        header.slotSize = sizeof(pair<bool, U>);
+        header.hashId = hashId();
+        std::vector<char> image = snapshotSlots(table, tableSize);
+        const void *tables[] = {image.data()};
+        writeSnapshot(path, header, tables);
+    }
+
+    // Replace the table contents with a memory-mapped snapshot, which is read in place without copying
+    void load(const string &path, bool verify = true) {
+        static_assert(std::is_trivially_copyable<U>::value, "Snapshots require trivially copyable elements");
+        SnapshotMapping mapping;
+        mapping.open(path, SNAPSHOT_LINEAR_PROBING, 1, sizeof(pair<bool, U>), hashId(), verify);
+        release(table);
+        snapshot.swap(mapping);
+        tableSize = snapshot.header().capacity;
+        table = reinterpret_cast<pair<bool, U> *>(snapshot.table(0));
     }
 
     bool contains(U item) const override {
@@ -0,0 +1,24 @@
+#ifndef ORDERED_CONTAINER_H
+#define ORDERED_CONTAINER_H
+
+#include "Container.hpp"
+
+#include <vector>
+
+using std::vector;
+
+/**
+ * A container which keeps its elements sorted and can therefore answer range queries.
+ *
+ * @tparam U is the type of element in this container
+ */
+template<class U>
+class OrderedContainer : public Container<U> {
+public:
+    /**
+     * @return all elements `x` with `low <= x <= high`, in ascending order
+     */
+    virtual vector<U> range(U low, U high) const = 0;
+};
+
+#endif
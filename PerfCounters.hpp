@@ -0,0 +1,187 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#endif
+
+using std::string;
+using std::vector;
+
+/**
+ * A set of Linux hardware performance counters (via `perf_event_open`), which can be switched on
+ * and off around individual operations and accumulate until reset. Only user-space events are
+ * counted, so the system calls used to start and stop the counters are mostly excluded.
+ * Counters which the CPU, kernel, or sandbox do not provide are skipped; on other platforms
+ * (or when `perf_event_paranoid` forbids access) no counters are available at all.
+ *
+ * Cycles and instructions are scheduled together as one group, while every cache and branch event
+ * forms a group of its own. A group only runs when all of its events fit onto the PMU at once,
+ * so this way an event which never gets a hardware counter (e.g. because the NMI watchdog holds
+ * one) cannot keep the others from counting; the kernel multiplexes the groups instead.
+ */
+class PerfCounters {
+    struct counter {
+        string name;
+        int fd;
+        // Index of the group leader, which is the counter itself for the first event of a group
+        unsigned leader;
+    };
+
+    vector<counter> counters;
+
+#ifdef __linux__
+
+    /**
+     * Open one event, returning false if it is unavailable.
+     *
+     * @param join adds the event to the group of the previously opened event (if any) instead of starting a new one
+     */
+    bool openEvent(const string &name, uint32_t type, uint64_t config, bool join = false) {
+        bool leader = !join || counters.empty();
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = leader ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        unsigned leaderIndex = leader ? (unsigned) counters.size() : counters.back().leader;
+        int groupFd = leader ? -1 : counters[leaderIndex].fd;
+        int fd = (int) syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0);
+        if (fd < 0) {
+            return false;
+        }
+        counters.push_back({name, fd, leaderIndex});
+        return true;
+    }
+
+    // Apply an ioctl to every group
+    void control(unsigned long request) {
+        for (unsigned i = 0; i < counters.size(); i++) {
+            if (counters[i].leader == i) {
+                ioctl(counters[i].fd, request, PERF_IOC_FLAG_GROUP);
+            }
+        }
+    }
+
+    static uint64_t cacheMiss(uint64_t cache) {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+#endif
+
+public:
+    explicit PerfCounters() {
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    ~PerfCounters() {
+        close();
+    }
+
+    /**
+     * Open every supported counter.
+     *
+     * @return the names of the counters which are unavailable
+     */
+    vector<string> open() {
+        close();
+        vector<string> missing;
+#ifdef __linux__
+        if (!openEvent("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES)) missing.push_back("cycles");
+        if (!openEvent("instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, true)) missing.push_back("instructions");
+        if (!openEvent("L1d misses", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D))) missing.push_back("L1d misses");
+        if (!openEvent("LLC misses", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL))) missing.push_back("LLC misses");
+        if (!openEvent("dTLB misses", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB))) missing.push_back("dTLB misses");
+        if (!openEvent("branch misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES)) missing.push_back("branch misses");
+#else
+        missing = {"cycles", "instructions", "L1d misses", "LLC misses", "dTLB misses", "branch misses"};
+#endif
+        return missing;
+    }
+
+    void close() {
+#ifdef __linux__
+        // Close group members before their leaders
+        for (auto it = counters.rbegin(); it != counters.rend(); it++) {
+            ::close(it->fd);
+        }
+#endif
+        counters.clear();
+    }
+
+    bool available() const {
+        return !counters.empty();
+    }
+
+    // Zero all counters
+    void reset() {
+#ifdef __linux__
+        control(PERF_EVENT_IOC_RESET);
+#endif
+    }
+
+    // Resume counting
+    void start() {
+#ifdef __linux__
+        control(PERF_EVENT_IOC_ENABLE);
+#endif
+    }
+
+    // Pause counting
+    void stop() {
+#ifdef __linux__
+        control(PERF_EVENT_IOC_DISABLE);
+#endif
+    }
+
+    /**
+     * Read the accumulated counts, scaled up if the kernel had to multiplex the counters.
+     *
+     * @return pairs of counter name and count, in the order the counters were opened; the count is NaN
+     * for counters which were never scheduled onto the PMU (or could not be read)
+     */
+    vector<std::pair<string, double>> read() const {
+        vector<std::pair<string, double>> result;
+#ifdef __linux__
+        for (const counter &c : counters) {
+            result.emplace_back(c.name, std::numeric_limits<double>::quiet_NaN());
+        }
+        for (unsigned i = 0; i < counters.size(); i++) {
+            if (counters[i].leader != i) continue;
+            unsigned members = 0;
+            while (i + members < counters.size() && counters[i + members].leader == i) {
+                members++;
+            }
+            // Layout for PERF_FORMAT_GROUP: count, time enabled, time running, then one value per counter
+            vector<uint64_t> values(3 + members);
+            ssize_t size = ::read(counters[i].fd, values.data(), values.size() * sizeof(uint64_t));
+            if (size < (ssize_t) (values.size() * sizeof(uint64_t)) || !values[2]) {
+                continue;
+            }
+            double scale = (double) values[1] / values[2];
+            for (unsigned j = 0; j < members; j++) {
+                result[i + j].second = values[3 + j] * scale;
+            }
+        }
+#endif
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,247 @@
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define SIMD_SSE2 1
+
+#include <emmintrin.h>
+
+#endif
+#if defined(__AVX2__)
+#define SIMD_AVX2 1
+#define SIMD_TARGET_AVX2
+#elif defined(SIMD_SSE2) && defined(__GNUC__)
+// AVX2 kernels are compiled separately and selected at runtime based on the CPU features
+#define SIMD_DISPATCH 1
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#if defined(SIMD_AVX2) || defined(SIMD_DISPATCH)
+
+#include <immintrin.h>
+
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+// Number of set bits in a SIMD comparison mask
+inline unsigned bitCount(unsigned mask) {
+#if defined(__GNUC__)
+    return (unsigned) __builtin_popcount(mask);
+#else
+    unsigned count = 0;
+    for (; mask; mask &= mask - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+const unsigned CACHE_LINE_SIZE = 64;
+
+// Allocate memory aligned to a cache line, which `new` does not guarantee before C++17;
+// the original allocation is stored just before the returned address
+inline void *allocateAligned(size_t bytes) {
+    char *memory = new char[bytes + sizeof(char *) + CACHE_LINE_SIZE - 1];
+    auto address = reinterpret_cast<uintptr_t>(memory + sizeof(char *));
+    auto aligned = reinterpret_cast<char *>((address + CACHE_LINE_SIZE - 1) & ~(uintptr_t) (CACHE_LINE_SIZE - 1));
+    reinterpret_cast<char **>(aligned)[-1] = memory;
+    return aligned;
+}
+
+// Free memory returned by `allocateAligned`
+inline void freeAligned(void *aligned) {
+    delete[] static_cast<char **>(aligned)[-1];
+}
+
+// Index of the lowest set bit in a non-zero SIMD comparison mask
+inline unsigned lowestBit(unsigned mask) {
+#if defined(__GNUC__)
+    return (unsigned) __builtin_ctz(mask);
+#else
+    unsigned index = 0;
+    for (; !(mask & 1); mask >>= 1) {
+        index++;
+    }
+    return index;
+#endif
+}
+
+/**
+ * Count the keys among the first `count` entries which are less than `x`.
+ * For sorted keys this is the index of the first key not less than `x`.
+ */
+template<class U>
+unsigned countLess(const U *keys, unsigned count, U x) {
+    unsigned less = 0;
+    for (unsigned i = 0; i < count; i++) {
+        less += keys[i] < x;
+    }
+    return less;
+}
+
+// Count the keys among the first `count` entries which are greater than `x`
+template<class U>
+unsigned countGreater(const U *keys, unsigned count, U x) {
+    unsigned greater = 0;
+    for (unsigned i = 0; i < count; i++) {
+        greater += x < keys[i];
+    }
+    return greater;
+}
+
+// Vectorized `countLess` for integer keys, comparing 8 (AVX2) or 4 (SSE2) keys per instruction
+inline unsigned countLess(const int *keys, unsigned count, int x) {
+    unsigned i = 0, less = 0;
+#ifdef SIMD_AVX2
+    __m256i wide = _mm256_set1_epi32(x);
+    for (; i + 8 <= count; i += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i));
+        less += bitCount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(wide, block))));
+    }
+#endif
+#ifdef SIMD_SSE2
+    __m128i narrow = _mm_set1_epi32(x);
+    for (; i + 4 <= count; i += 4) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+        less += bitCount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(narrow, block))));
+    }
+#endif
+    for (; i < count; i++) {
+        less += keys[i] < x;
+    }
+    return less;
+}
+
+// Vectorized `countGreater` for integer keys
+inline unsigned countGreater(const int *keys, unsigned count, int x) {
+    unsigned i = 0, greater = 0;
+#ifdef SIMD_AVX2
+    __m256i wide = _mm256_set1_epi32(x);
+    for (; i + 8 <= count; i += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i));
+        greater += bitCount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(block, wide))));
+    }
+#endif
+#ifdef SIMD_SSE2
+    __m128i narrow = _mm_set1_epi32(x);
+    for (; i + 4 <= count; i += 4) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+        greater += bitCount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(block, narrow))));
+    }
+#endif
+    for (; i < count; i++) {
+        greater += x < keys[i];
+    }
+    return greater;
+}
+
+// Scans shorter than this skip the runtime dispatch and use the baseline instruction set
+const unsigned SIMD_DISPATCH_THRESHOLD = 32;
+
+/**
+ * Find the first of `count` keys which is equal to `x`.
+ *
+ * @return the index of the matching key, or `count` if there is none
+ */
+template<class U>
+unsigned findEqual(const U *keys, unsigned count, U x) {
+    for (unsigned i = 0; i < count; i++) {
+        if (keys[i] == x) {
+            return i;
+        }
+    }
+    return count;
+}
+
+// `findEqual` for integer keys using only the instruction set enabled at compile time
+inline unsigned findEqualBaseline(const int *keys, unsigned count, int x) {
+    unsigned i = 0;
+#ifdef SIMD_SSE2
+    __m128i needle = _mm_set1_epi32(x);
+    // Compare 16 keys per iteration and only locate the match once any of them is equal
+    for (; i + 16 <= count; i += 16) {
+        auto block = reinterpret_cast<const __m128i *>(keys + i);
+        __m128i any = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi32(needle, _mm_loadu_si128(block)),
+                             _mm_cmpeq_epi32(needle, _mm_loadu_si128(block + 1))),
+                _mm_or_si128(_mm_cmpeq_epi32(needle, _mm_loadu_si128(block + 2)),
+                             _mm_cmpeq_epi32(needle, _mm_loadu_si128(block + 3))));
+        if (_mm_movemask_epi8(any)) {
+            break;
+        }
+    }
+    for (; i + 4 <= count; i += 4) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+        unsigned mask = (unsigned) _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(needle, block)));
+        if (mask) {
+            return i + lowestBit(mask);
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        if (keys[i] == x) {
+            return i;
+        }
+    }
+    return count;
+}
+
+#if defined(SIMD_AVX2) || defined(SIMD_DISPATCH)
+
+// `findEqual` for integer keys using AVX2, comparing 32 keys per iteration
+SIMD_TARGET_AVX2 inline unsigned findEqualAvx2(const int *keys, unsigned count, int x) {
+    unsigned i = 0;
+    __m256i needle = _mm256_set1_epi32(x);
+    for (; i + 32 <= count; i += 32) {
+        auto block = reinterpret_cast<const __m256i *>(keys + i);
+        __m256i any = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi32(needle, _mm256_loadu_si256(block)),
+                                _mm256_cmpeq_epi32(needle, _mm256_loadu_si256(block + 1))),
+                _mm256_or_si256(_mm256_cmpeq_epi32(needle, _mm256_loadu_si256(block + 2)),
+                                _mm256_cmpeq_epi32(needle, _mm256_loadu_si256(block + 3))));
+        if (!_mm256_testz_si256(any, any)) {
+            break;
+        }
+    }
+    for (; i + 8 <= count; i += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i));
+        unsigned mask = (unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(needle, block)));
+        if (mask) {
+            return i + lowestBit(mask);
+        }
+    }
+    for (; i < count; i++) {
+        if (keys[i] == x) {
+            return i;
+        }
+    }
+    return count;
+}
+
+#endif
+
+typedef unsigned (*FindEqualKernel)(const int *, unsigned, int);
+
+// Choose the widest `findEqual` kernel supported by the current CPU
+inline FindEqualKernel selectFindEqual() {
+#if defined(SIMD_AVX2)
+    return findEqualAvx2;
+#elif defined(SIMD_DISPATCH)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? findEqualAvx2 : findEqualBaseline;
+#else
+    return findEqualBaseline;
+#endif
+}
+
+// Vectorized `findEqual` for integer keys
+inline unsigned findEqual(const int *keys, unsigned count, int x) {
+    if (count < SIMD_DISPATCH_THRESHOLD) {
+        return findEqualBaseline(keys, count, x);
+    }
+    static const FindEqualKernel kernel = selectFindEqual();
+    return kernel(keys, count, x);
+}
+
+#endif
@@ -0,0 +1,245 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SNAPSHOT_MMAP 1
+#endif
+
+using std::string;
+using std::runtime_error;
+
+// Identifies the slot layout stored in a snapshot file
+enum SnapshotKind : uint32_t {
+    SNAPSHOT_LINEAR_PROBING = 1,
+    SNAPSHOT_CUCKOO = 2,
+};
+
+const char SNAPSHOT_MAGIC[8] = {'C', 'S', 'C', 'I', 'S', 'N', 'P', '1'};
+const uint64_t SNAPSHOT_FNV_OFFSET = 14695981039346656037ull;
+const uint64_t SNAPSHOT_FNV_PRIME = 1099511628211ull;
+
+/**
+ * The fixed-size header at the start of every snapshot file. It holds only sizes and identifiers
+ * (never pointers), so the image stays valid wherever it is mapped. The slot arrays follow the
+ * header back to back, one per table, each `capacity * slotSize` bytes long.
+ */
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t kind;
+    uint32_t tableCount;
+    uint32_t capacity;
+    uint32_t slotSize;
+    uint64_t hashId;
+    uint64_t checksum;
+    // Pad to a full cache line so that the first slot is line-aligned in the mapping
+    char reserved[24];
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "Snapshot header must be exactly one cache line");
+
+// Fold a byte range into a 64-bit FNV-1a checksum
+inline uint64_t snapshotChecksum(const void *data, size_t length, uint64_t state = SNAPSHOT_FNV_OFFSET) {
+    auto bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < length; i++) {
+        state = (state ^ bytes[i]) * SNAPSHOT_FNV_PRIME;
+    }
+    return state;
+}
+
+/**
+ * Copy a slot array into a canonical image: padding bytes and the elements of empty slots are zeroed,
+ * so that logically identical tables produce identical files and checksums, and no stale heap
+ * contents are written to disk.
+ */
+template<class U>
+std::vector<char> snapshotSlots(const std::pair<bool, U> *slots, size_t capacity) {
+    typedef std::pair<bool, U> slot;
+    std::vector<char> image(capacity * sizeof(slot), 0);
+    for (size_t i = 0; i < capacity; i++) {
+        if (slots[i].first) {
+            char *target = image.data() + i * sizeof(slot);
+            bool occupied = true;
+            memcpy(target + offsetof(slot, first), &occupied, sizeof(bool));
+            memcpy(target + offsetof(slot, second), &slots[i].second, sizeof(U));
+        }
+    }
+    return image;
+}
+
+/**
+ * Write a snapshot file consisting of the given header followed by `header.tableCount` slot arrays.
+ * The checksum field is computed here over the concatenated slot arrays.
+ */
+inline void writeSnapshot(const string &path, SnapshotHeader header, const void *const *tables) {
+    size_t tableBytes = (size_t) header.capacity * header.slotSize;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    memset(header.reserved, 0, sizeof(header.reserved));
+    header.checksum = SNAPSHOT_FNV_OFFSET;
+    for (uint32_t n = 0; n < header.tableCount; n++) {
+        header.checksum = snapshotChecksum(tables[n], tableBytes, header.checksum);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw runtime_error("Could not open snapshot file for writing: " + path);
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    for (uint32_t n = 0; n < header.tableCount; n++) {
+        file.write(static_cast<const char *>(tables[n]), tableBytes);
+    }
+    if (!file.good()) {
+        throw runtime_error("Could not write snapshot file: " + path);
+    }
+}
+
+/**
+ * An owned view of a snapshot file. On POSIX systems the file is mapped copy-on-write, so tables
+ * may read slots directly from the page cache and still modify them without touching the file.
+ * Other platforms fall back to reading the whole file into a heap buffer.
+ */
+class SnapshotMapping {
+    char *address = nullptr;
+    size_t length = 0;
+
+public:
+    SnapshotMapping() = default;
+
+    SnapshotMapping(const SnapshotMapping &) = delete;
+
+    SnapshotMapping &operator=(const SnapshotMapping &) = delete;
+
+    ~SnapshotMapping() {
+        unmap();
+    }
+
+    bool mapped() const {
+        return address != nullptr;
+    }
+
+    const SnapshotHeader &header() const {
+        return *reinterpret_cast<const SnapshotHeader *>(address);
+    }
+
+    // Returns a pointer to the first slot of the table at index `n`
+    char *table(unsigned n) const {
+        return address + sizeof(SnapshotHeader) + (size_t) n * header().capacity * header().slotSize;
+    }
+
+    void swap(SnapshotMapping &other) {
+        std::swap(address, other.address);
+        std::swap(length, other.length);
+    }
+
+    /**
+     * Map a snapshot file and check that it matches the expected layout.
+     * Verifying the checksum touches every page, so it can be skipped when startup latency matters.
+     */
+    void open(const string &path, uint32_t kind, uint32_t tableCount, uint32_t slotSize, uint64_t hashId,
+              bool verify) {
+        unmap();
+        map(path);
+
+        const char *error = nullptr;
+        const SnapshotHeader &h = header();
+        if (length < sizeof(SnapshotHeader) || memcmp(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic)) != 0) {
+            error = "not a snapshot file";
+        } else if (h.kind != kind || h.tableCount != tableCount || h.slotSize != slotSize) {
+            error = "snapshot was saved from a different container type";
+        } else if (h.hashId != hashId) {
+            error = "snapshot was saved with a different hash function";
+        } else if (!h.capacity ||
+                   length != sizeof(SnapshotHeader) + (size_t) h.capacity * h.slotSize * h.tableCount) {
+            error = "snapshot size does not match its header";
+        } else if (verify && snapshotChecksum(table(0), length - sizeof(SnapshotHeader)) != h.checksum) {
+            error = "snapshot checksum mismatch";
+        }
+        if (error) {
+            unmap();
+            throw runtime_error("Could not load snapshot " + path + ": " + error);
+        }
+    }
+
+    void unmap() {
+        if (!address) {
+            return;
+        }
+#ifdef SNAPSHOT_MMAP
+        munmap(address, length);
+#else
+        delete[] address;
+#endif
+        address = nullptr;
+        length = 0;
+    }
+
+private:
+    void map(const string &path) {
+#ifdef SNAPSHOT_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw runtime_error("Snapshot file not found: " + path);
+        }
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || info.st_size < (off_t) sizeof(SnapshotHeader)) {
+            close(fd);
+            throw runtime_error("Snapshot file is truncated: " + path);
+        }
+        void *region = mmap(nullptr, (size_t) info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (region == MAP_FAILED) {
+            throw runtime_error("Could not map snapshot file: " + path);
+        }
+        address = static_cast<char *>(region);
+        length = (size_t) info.st_size;
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            throw runtime_error("Snapshot file not found: " + path);
+        }
+        length = (size_t) file.tellg();
+        if (length < sizeof(SnapshotHeader)) {
+            length = 0;
+            throw runtime_error("Snapshot file is truncated: " + path);
+        }
+        address = new char[length];
+        file.seekg(0);
+        file.read(address, length);
+#endif
+    }
+};
+
+// Fold a hash function output into a hash function ID
+inline uint64_t snapshotMix(uint64_t state, unsigned value) {
+    return snapshotChecksum(&value, sizeof(value), state);
+}
+
+// Number of sample inputs used to fingerprint a hash function
+const unsigned SNAPSHOT_HASH_SAMPLES = 64;
+
+// Deterministic sample input for hash function fingerprinting
+template<class U>
+U snapshotSample(unsigned i) {
+    return static_cast<U>(i * 2654435761u >> 1);
+}
+
+// Sample capacity for hash function fingerprinting (hash functions may depend on the capacity)
+inline unsigned snapshotSampleCapacity(unsigned i) {
+    return 1009 + i * 997;
+}
+
+#endif
@@ -2,12 +2,11 @@
 #define VECTOR_LIST_H
 
 #include "Container.hpp"
+#include "SimdSearch.hpp"
 
 #include <vector>
-#include <algorithm>
 
 using std::vector;
-using std::find;
 
 /**
  * A wrapper for common `std::vector` operations.
@@ -24,7 +23,7 @@ public:
     }
 
     bool contains(U x) const override {
-        return find(vec.begin(), vec.end(), x) != vec.end();
+        return findEqual(vec.data(), vec.size(), x) != vec.size();
     }
 
     bool insert(U x) override {
@@ -33,13 +32,12 @@ public:
     }
 
     bool remove(U x) override {
-        for (unsigned i = 0; i < vec.size(); i++) {
-            if (vec[i] == x) {
-                vec.erase(vec.begin() + i);
-                return true;
-            }
+        unsigned i = findEqual(vec.data(), vec.size(), x);
+        if (i == vec.size()) {
+            return false;
         }
-        return false;
+        vec.erase(vec.begin() + i);
+        return true;
     }
 };
 
@@ -0,0 +1,189 @@
+#ifndef VERSIONED_TABLE_H
+#define VERSIONED_TABLE_H
+
+#include "Container.hpp"
+#include "SimdSearch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using std::atomic;
+using std::vector;
+
+/**
+ * A read-mostly wrapper for a copyable table (e.g. `LinearHashTable` or `CuckooTable`) which allows
+ * many concurrent readers and a single writer.
+ *
+ * Readers only ever see immutable, atomically published versions of the table, so a lookup costs a
+ * single acquire load on top of the wrapped table's own `contains`. The writer applies updates to a
+ * private working copy and makes them visible as a batch with `publish`. Replaced versions are
+ * reclaimed with epoch-based reclamation: each reader announces the global epoch when it enters a
+ * read-side section, and a version is freed once every active reader entered after it was retired.
+ *
+ * @tparam T is the type of the wrapped table
+ * @tparam U is the type of element stored in the table
+ */
+template<class T, class U>
+class VersionedTable : public Container<U> {
+public:
+    // An immutable version of the table
+    struct version {
+        T table;
+        // Number of versions published before this one
+        uint64_t number;
+        std::chrono::steady_clock::time_point published;
+
+        version(const T &table, uint64_t number) : table(table), number(number) {
+        }
+    };
+
+    // Maximum number of reader threads which may be registered at once
+    static const unsigned MAX_READERS = 1024;
+
+private:
+    // Epoch announced by a reader while inside a read-side section, or 0; padded to avoid false sharing
+    struct alignas(CACHE_LINE_SIZE) readerSlot {
+        atomic<uint64_t> epoch;
+        atomic<bool> used;
+    };
+
+    struct retiredVersion {
+        version *replaced;
+        uint64_t epoch;
+    };
+
+    atomic<version *> current;
+    atomic<uint64_t> globalEpoch;
+    // Number of slots which have ever been registered, i.e. the slots scanned by `reclaim`
+    atomic<unsigned> readerCount;
+    readerSlot readers[MAX_READERS];
+
+    // State which is only accessed by the writer
+    T working;
+    vector<retiredVersion> retired;
+
+    // Free every retired version which no active reader can still be using
+    void reclaim() {
+        uint64_t oldest = UINT64_MAX;
+        unsigned count = readerCount.load();
+        for (unsigned i = 0; i < count; i++) {
+            uint64_t epoch = readers[i].epoch.load();
+            if (epoch && epoch < oldest) {
+                oldest = epoch;
+            }
+        }
+        unsigned kept = 0;
+        for (const retiredVersion &r : retired) {
+            // A reader which announced a later epoch than the retirement cannot have loaded the old version
+            if (r.epoch < oldest) {
+                delete r.replaced;
+            } else {
+                retired[kept++] = r;
+            }
+        }
+        retired.resize(kept);
+    }
+
+public:
+    explicit VersionedTable(unsigned size) : working(size) {
+        current.store(new version(working, 0));
+        globalEpoch.store(1);
+        readerCount.store(0);
+        for (readerSlot &slot : readers) {
+            slot.epoch.store(0);
+            slot.used.store(false);
+        }
+    }
+
+    VersionedTable(const VersionedTable &) = delete;
+
+    VersionedTable &operator=(const VersionedTable &) = delete;
+
+    // All reader threads must have left their read-side sections before the table is destroyed
+    ~VersionedTable() {
+        for (const retiredVersion &r : retired) {
+            delete r.replaced;
+        }
+        delete current.load();
+    }
+
+    unsigned capacity() const override {
+        return working.capacity();
+    }
+
+    // Register a reader thread, returning its slot for `enter` and `leave`
+    unsigned registerReader() {
+        for (unsigned reader = 0; reader < MAX_READERS; reader++) {
+            bool used = false;
+            if (readers[reader].used.compare_exchange_strong(used, true)) {
+                // Make sure that the writer scans this slot when reclaiming
+                unsigned count = readerCount.load();
+                while (count <= reader && !readerCount.compare_exchange_weak(count, reader + 1)) {
+                }
+                return reader;
+            }
+        }
+        throw std::runtime_error("Too many readers registered with versioned table");
+    }
+
+    // Release the slot of a reader thread which has left its last read-side section, so it can be reused
+    void unregisterReader(unsigned reader) {
+        readers[reader].epoch.store(0, std::memory_order_release);
+        readers[reader].used.store(false, std::memory_order_release);
+    }
+
+    // Begin a read-side section; published versions remain valid until the matching `leave`
+    void enter(unsigned reader) {
+        readers[reader].epoch.store(globalEpoch.load(), std::memory_order_relaxed);
+        // Order the announcement before any version loads (pairs with the fence in `publish`)
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    // End a read-side section
+    void leave(unsigned reader) {
+        readers[reader].epoch.store(0, std::memory_order_release);
+    }
+
+    // Current published version; must be called inside a read-side section or by the writer
+    const version *snapshot() const {
+        return current.load(std::memory_order_acquire);
+    }
+
+    // Looks up the published version; must be called inside a read-side section or by the writer
+    bool contains(U x) const override {
+        return snapshot()->table.contains(x);
+    }
+
+    // Writer only; the result reflects the working copy, but is not visible to readers until `publish`
+    bool insert(U x) override {
+        return working.insert(x);
+    }
+
+    // Writer only; the result reflects the working copy, but is not visible to readers until `publish`
+    bool remove(U x) override {
+        return working.remove(x);
+    }
+
+    // Writer only; atomically make all updates since the previous call visible to readers
+    void publish() {
+        version *next = new version(working, snapshot()->number + 1);
+        next->published = std::chrono::steady_clock::now();
+        version *replaced = current.exchange(next, std::memory_order_seq_cst);
+        // Readers which announce the new epoch are guaranteed to load `next` or a later version
+        uint64_t epoch = globalEpoch.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        retired.push_back({replaced, epoch});
+        reclaim();
+    }
+
+    // Number of replaced versions which are still waiting for readers to leave
+    unsigned pendingReclamation() const {
+        return retired.size();
+    }
+};
+
+#endif
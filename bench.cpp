@@ -0,0 +1,322 @@
+// Global imports
+#include <iostream>
+
+using std::cout;
+using std::endl;
+
+// Project-level imports
+#include "BalancedTree.hpp"
+#include "BPlusTree.hpp"
+#include "EytzingerArray.hpp"
+#include "SinglyLinkedList.hpp"
+#include "FlatBucket.hpp"
+#include "VectorList.hpp"
+#include "BucketHashTable.hpp"
+#include "LinearHashTable.hpp"
+#include "CuckooTable.hpp"
+#include "FilteredContainer.hpp"
+#include "HashFunctions.hpp"
+#include "DataSet.hpp"
+
+// Standard library imports
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+const unsigned TABLE_SIZE = 10009;
+const unsigned OPERATION_COUNT = 3;
+const char *const OPERATIONS[OPERATION_COUNT] = {"insert", "contains", "remove"};
+
+// A change is only reported as a regression if it is significant at this level
+const double SIGNIFICANCE_LEVEL = 0.01;
+// Default minimum slowdown, since run-to-run noise on a shared machine is typically several percent
+const double DEFAULT_THRESHOLD = 0.1;
+
+// Receives the results of every timed pass, so that the compiler cannot optimize the operations away
+volatile unsigned benchSink;
+
+// Summary statistics of the per-operation latency (in nanoseconds) over all samples
+struct Summary {
+    string container;
+    string operation;
+    unsigned samples = 0;
+    double mean = 0;
+    double stddev = 0;
+};
+
+Summary summarize(const string &container, const string &operation, const vector<double> &samples) {
+    Summary s;
+    s.container = container;
+    s.operation = operation;
+    s.samples = samples.size();
+    for (double x : samples) {
+        s.mean += x;
+    }
+    s.mean /= samples.size();
+    for (double x : samples) {
+        s.stddev += (x - s.mean) * (x - s.mean);
+    }
+    s.stddev = samples.size() > 1 ? sqrt(s.stddev / (samples.size() - 1)) : 0;
+    return s;
+}
+
+// Continued fraction for the regularized incomplete beta function (modified Lentz's method)
+double betaFraction(double a, double b, double x) {
+    const double tiny = 1e-300;
+    double c = 1, d = 1 - (a + b) * x / (a + 1);
+    d = 1 / (fabs(d) < tiny ? tiny : d);
+    double h = d;
+    for (unsigned m = 1; m <= 200; m++) {
+        for (unsigned step = 0; step < 2; step++) {
+            double numerator = step == 0
+                               ? m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m))
+                               : -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+            d = 1 + numerator * d;
+            d = 1 / (fabs(d) < tiny ? tiny : d);
+            c = 1 + numerator / c;
+            c = fabs(c) < tiny ? tiny : c;
+            h *= d * c;
+        }
+        if (fabs(d * c - 1) < 1e-12) {
+            break;
+        }
+    }
+    return h;
+}
+
+// Regularized incomplete beta function I_x(a, b)
+double incompleteBeta(double a, double b, double x) {
+    if (x <= 0) return 0;
+    if (x >= 1) return 1;
+    double front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1 - x));
+    if (x < (a + 1) / (a + b + 2)) {
+        return front * betaFraction(a, b, x) / a;
+    }
+    return 1 - front * betaFraction(b, a, 1 - x) / b;
+}
+
+// One-sided p-value of Welch's t-test for the current mean being larger than the baseline mean
+double welchPValue(const Summary &baseline, const Summary &current) {
+    double vb = baseline.stddev * baseline.stddev / baseline.samples;
+    double vc = current.stddev * current.stddev / current.samples;
+    if (vb + vc == 0) {
+        return current.mean > baseline.mean ? 0 : 1;
+    }
+    double t = (current.mean - baseline.mean) / sqrt(vb + vc);
+    double df = (vb + vc) * (vb + vc) /
+                (vb * vb / max(1u, baseline.samples - 1) + vc * vc / max(1u, current.samples - 1));
+    double tail = 0.5 * incompleteBeta(df / 2, 0.5, df / (df + t * t));
+    return t > 0 ? tail : 1 - tail;
+}
+
+// Time one pass of an operation over the dataset, returning the average nanoseconds per item
+template<class F>
+double timePhase(const vector<int> &data, F operation) {
+    unsigned results = 0;
+    auto start = steady_clock::now();
+    for (int x : data) {
+        results += operation(x);
+    }
+    auto stop = steady_clock::now();
+    benchSink = results;
+    return (double) duration_cast<nanoseconds>(stop - start).count() / data.size();
+}
+
+// Time every operation on a freshly constructed container
+template<class C>
+void measure(C &table, const vector<int> &data, double *times) {
+    times[0] = timePhase(data, [&](int x) { return table.insert(x); });
+    times[1] = timePhase(data, [&](int x) { return table.contains(x); });
+    times[2] = timePhase(data, [&](int x) { return table.remove(x); });
+}
+
+// Runs one warm-up pass and then collects the given number of samples for each operation
+void benchmark(const string &label, unsigned sampleCount, const function<void(double *)> &run,
+               vector<Summary> &summaries) {
+    double times[OPERATION_COUNT];
+    run(times);
+    vector<double> samples[OPERATION_COUNT];
+    for (unsigned s = 0; s < sampleCount; s++) {
+        run(times);
+        for (unsigned op = 0; op < OPERATION_COUNT; op++) {
+            samples[op].push_back(times[op]);
+        }
+    }
+    cout << endl;
+    cout << "[" << label << "]" << endl;
+    for (unsigned op = 0; op < OPERATION_COUNT; op++) {
+        Summary s = summarize(label, OPERATIONS[op], samples[op]);
+        cout << "* " << s.operation << ": " << s.mean << " ns (stddev " << s.stddev << ")" << endl;
+        summaries.push_back(s);
+    }
+}
+
+void saveSummaries(const string &path, const vector<Summary> &summaries) {
+    ofstream file(path);
+    if (!file.good()) {
+        throw runtime_error("Could not write benchmark summary: " + path);
+    }
+    file << "container,operation,samples,mean_ns,stddev_ns,ops_per_second" << endl;
+    for (const Summary &s : summaries) {
+        file << s.container << "," << s.operation << "," << s.samples << "," << s.mean << "," << s.stddev << ","
+             << 1e9 / s.mean << endl;
+    }
+}
+
+vector<Summary> loadSummaries(const string &path) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        throw runtime_error("Benchmark baseline not found: " + path);
+    }
+    vector<Summary> summaries;
+    string line;
+    getline(file, line);
+    while (getline(file, line)) {
+        stringstream ss(line);
+        Summary s;
+        string token;
+        getline(ss, s.container, ',');
+        getline(ss, s.operation, ',');
+        getline(ss, token, ',');
+        s.samples = (unsigned) stoul(token);
+        getline(ss, token, ',');
+        s.mean = stod(token);
+        getline(ss, token, ',');
+        s.stddev = stod(token);
+        summaries.push_back(s);
+    }
+    return summaries;
+}
+
+// Compares a run against a baseline, returning the number of significant regressions
+unsigned compareSummaries(const vector<Summary> &baseline, const vector<Summary> &current, double threshold) {
+    cout << endl;
+    cout << "Comparing against baseline (one-sided Welch's t-test, p < " << SIGNIFICANCE_LEVEL
+         << ", slowdown > " << threshold * 100 << "%)..." << endl;
+    unsigned regressions = 0;
+    for (const Summary &c : current) {
+        const Summary *b = nullptr;
+        for (const Summary &s : baseline) {
+            if (s.container == c.container && s.operation == c.operation) {
+                b = &s;
+            }
+        }
+        if (!b) {
+            cout << "* " << c.container << " / " << c.operation << ": not in baseline" << endl;
+            continue;
+        }
+        double latencyChange = c.mean / b->mean - 1;
+        double throughputChange = b->mean / c.mean - 1;
+        double p = welchPValue(*b, c);
+        bool regression = p < SIGNIFICANCE_LEVEL && latencyChange > threshold;
+        cout << (regression ? ">> REGRESSION " : "* ") << c.container << " / " << c.operation << ": latency "
+             << (latencyChange >= 0 ? "+" : "") << latencyChange * 100 << "%, throughput "
+             << (throughputChange >= 0 ? "+" : "") << throughputChange * 100 << "% (p = " << p << ")" << endl;
+        regressions += regression;
+    }
+    return regressions;
+}
+
+int main(int argc, char **argv) {
+    string inputPath = "data/dataSetC.csv";
+    string savePath, comparePath;
+    unsigned size = 10000;
+    unsigned sampleCount = 20;
+    double threshold = DEFAULT_THRESHOLD;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--save" && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if (arg == "--compare" && i + 1 < argc) {
+            comparePath = argv[++i];
+        } else if (arg == "--size" && i + 1 < argc) {
+            size = (unsigned) stoul(argv[++i]);
+        } else if (arg == "--samples" && i + 1 < argc) {
+            sampleCount = (unsigned) stoul(argv[++i]);
+        } else if (arg == "--threshold" && i + 1 < argc) {
+            threshold = stod(argv[++i]);
+        } else if (arg.compare(0, 2, "--") != 0) {
+            inputPath = arg;
+        } else {
+            cout << "Usage: " << argv[0]
+                 << " [input-file] [--size N] [--samples N] [--save summary.csv]"
+                 << " [--compare baseline.csv] [--threshold fraction]" << endl;
+            return 2;
+        }
+    }
+
+    cout << "Loading dataset: " << inputPath << endl;
+    vector<int> data = loadData(inputPath);
+    if (data.size() > size) {
+        data.resize(size);
+    }
+    cout << "Benchmarking " << data.size() << " items, " << sampleCount << " samples per operation..." << endl;
+
+    vector<Summary> summaries;
+    benchmark("baseline: balanced tree", sampleCount, [&](double *times) {
+        BalancedTree<int> table;
+        measure(table, data, times);
+    }, summaries);
+    benchmark("baseline: b+ tree", sampleCount, [&](double *times) {
+        BPlusTree<int> table;
+        measure(table, data, times);
+    }, summaries);
+    benchmark("baseline: eytzinger array", sampleCount, [&](double *times) {
+        EytzingerArray<int> table;
+        measure(table, data, times);
+    }, summaries);
+    benchmark("baseline: linked list", sampleCount, [&](double *times) {
+        SinglyLinkedList<int> table;
+        measure(table, data, times);
+    }, summaries);
+    benchmark("baseline: vector", sampleCount, [&](double *times) {
+        VectorList<int> table;
+        measure(table, data, times);
+    }, summaries);
+    benchmark("linked list {h(x)}", sampleCount, [&](double *times) {
+        BucketHashTable<SinglyLinkedList<int>, int, hash1, TABLE_SIZE> table;
+        measure(table, data, times);
+    }, summaries);
+    benchmark("flat bucket {h(x)}", sampleCount, [&](double *times) {
+        BucketHashTable<FlatBucket<int>, int, hash1, TABLE_SIZE> table;
+        measure(table, data, times);
+    }, summaries);
+    benchmark("binary tree {h(x)}", sampleCount, [&](double *times) {
+        BucketHashTable<BalancedTree<int>, int, hash1, TABLE_SIZE> table;
+        measure(table, data, times);
+    }, summaries);
+    benchmark("b+ tree {h(x)}", sampleCount, [&](double *times) {
+        BucketHashTable<BPlusTree<int>, int, hash1, TABLE_SIZE> table;
+        measure(table, data, times);
+    }, summaries);
+    benchmark("linear probing {h(x)}", sampleCount, [&](double *times) {
+        LinearHashTable<int, hash1> table(TABLE_SIZE);
+        measure(table, data, times);
+    }, summaries);
+    benchmark("filtered linear probing {h(x)}", sampleCount, [&](double *times) {
+        LinearHashTable<int, hash1> table(TABLE_SIZE);
+        FilteredContainer<int> filtered(table, data.size());
+        measure(filtered, data, times);
+    }, summaries);
+    benchmark("cuckoo hashing {3}", sampleCount, [&](double *times) {
+        CuckooTable<int, multiHash, 3> table(TABLE_SIZE);
+        measure(table, data, times);
+    }, summaries);
+
+    if (!savePath.empty()) {
+        saveSummaries(savePath, summaries);
+        cout << endl << "Saved summary: " << savePath << endl;
+    }
+    if (!comparePath.empty()) {
+        unsigned regressions = compareSummaries(loadSummaries(comparePath), summaries, threshold);
+        cout << endl << "Regressions: " << regressions << endl;
+        return regressions ? 1 : 0;
+    }
+}
@@ -0,0 +1,175 @@
+// Global imports
+#include <iostream>
+
+using std::cout;
+using std::endl;
+
+// Project-level imports
+#include "LinearHashTable.hpp"
+#include "CuckooTable.hpp"
+#include "VersionedTable.hpp"
+#include "HashFunctions.hpp"
+#include "DataSet.hpp"
+
+// Standard library imports
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+const unsigned TABLE_SIZE = 10009;
+// Number of updates the writer publishes as one version
+const unsigned UPDATE_BATCH_SIZE = 100;
+// Pause between publications, so that the workload stays read-mostly
+const microseconds UPDATE_INTERVAL(1000);
+// Number of lookups per read-side section
+const unsigned READ_SECTION_SIZE = 256;
+
+// Statistics gathered by a single reader thread
+struct ReaderResult {
+    unsigned long long lookups = 0;
+    unsigned long long hits = 0;
+    unsigned long long versionsSeen = 0;
+    long long totalLatency = 0;
+    long long maxLatency = 0;
+};
+
+// Looks up the first `count` items of the dataset, which stay present in every version
+template<class T>
+void readLoop(VersionedTable<T, int> &table, const vector<int> &data, unsigned count,
+              const atomic<bool> &running, unsigned offset, ReaderResult &result) {
+    unsigned reader = table.registerReader();
+    unsigned index = offset % count;
+    // Only count versions published after this reader started
+    table.enter(reader);
+    uint64_t seen = table.snapshot()->number;
+    table.leave(reader);
+    while (running.load(memory_order_relaxed)) {
+        table.enter(reader);
+        for (unsigned i = 0; i < READ_SECTION_SIZE; i++) {
+            auto current = table.snapshot();
+            if (current->number != seen) {
+                // Measure the time between publication and the first lookup which uses the new version
+                long long latency = duration_cast<nanoseconds>(steady_clock::now() - current->published).count();
+                seen = current->number;
+                result.versionsSeen++;
+                result.totalLatency += latency;
+                result.maxLatency = max(result.maxLatency, latency);
+            }
+            result.hits += current->table.contains(data[index]);
+            if (++index == count) {
+                index = 0;
+            }
+        }
+        table.leave(reader);
+        result.lookups += READ_SECTION_SIZE;
+    }
+    table.unregisterReader(reader);
+}
+
+// Runs concurrent readers against a single writer which keeps publishing batches of updates
+template<class T>
+void profileConcurrent(const vector<int> &data, unsigned readerCount, milliseconds runTime, const string &label) {
+    cout << endl;
+    cout << "[" << label << "]" << endl;
+
+    // Start with the first half of the dataset, and let the writer cycle the remaining items in and out
+    VersionedTable<T, int> table(TABLE_SIZE);
+    unsigned half = data.size() / 2;
+    if (!half) {
+        cout << ">> skipped: the dataset needs at least two items" << endl;
+        return;
+    }
+    for (unsigned i = 0; i < half; i++) {
+        table.insert(data[i]);
+    }
+    table.publish();
+    // Skip duplicates of the first half, so that readers always find every item they look up; if none
+    // are left, the writer keeps publishing unchanged versions
+    vector<int> updates;
+    for (unsigned i = half; i < data.size(); i++) {
+        if (!table.contains(data[i])) {
+            updates.push_back(data[i]);
+        }
+    }
+
+    atomic<bool> running(true);
+    vector<ReaderResult> results(readerCount);
+    vector<thread> readers;
+    for (unsigned r = 0; r < readerCount; r++) {
+        readers.emplace_back(readLoop<T>, ref(table), cref(data), half, cref(running), r * 7919, ref(results[r]));
+    }
+
+    auto start = steady_clock::now();
+    unsigned publishCount = 0;
+    unsigned index = 0;
+    bool inserting = true;
+    while (steady_clock::now() - start < runTime) {
+        for (unsigned i = 0; i < UPDATE_BATCH_SIZE && !updates.empty(); i++) {
+            if (inserting) {
+                table.insert(updates[index]);
+            } else {
+                table.remove(updates[index]);
+            }
+            if (++index == updates.size()) {
+                index = 0;
+                inserting = !inserting;
+            }
+        }
+        table.publish();
+        publishCount++;
+        this_thread::sleep_for(UPDATE_INTERVAL);
+    }
+    running.store(false);
+    for (thread &t : readers) {
+        t.join();
+    }
+    double seconds = duration_cast<duration<double>>(steady_clock::now() - start).count();
+
+    ReaderResult total;
+    for (const ReaderResult &r : results) {
+        total.lookups += r.lookups;
+        total.hits += r.hits;
+        total.versionsSeen += r.versionsSeen;
+        total.totalLatency += r.totalLatency;
+        total.maxLatency = max(total.maxLatency, r.maxLatency);
+    }
+    cout << "* read throughput: " << (long long) (total.lookups / seconds) << " lookups/s ("
+         << (long long) (total.lookups / seconds / readerCount) << " per reader)" << endl;
+    if (total.hits != total.lookups) {
+        cout << ">> unexpected: " << total.lookups - total.hits << " lookups missed" << endl;
+    }
+    cout << "* publications: " << publishCount << " (pending reclamation: " << table.pendingReclamation() << ")"
+         << endl;
+    if (total.versionsSeen) {
+        cout << "* update visibility: " << total.totalLatency / (long long) total.versionsSeen << " ns average, "
+             << total.maxLatency << " ns max" << endl;
+    }
+}
+
+int main(int argc, char **argv) {
+    // Retrieve dataset file path from first command line argument
+    string inputPath = argc > 1 ? argv[1] : "data/dataSetC.csv";
+    // Retrieve the number of reader threads from the second command line argument
+    unsigned readerCount = argc > 2 ? (unsigned) stoi(argv[2]) : max(2u, thread::hardware_concurrency());
+    // Retrieve the duration of each run in milliseconds from the third command line argument
+    milliseconds runTime(argc > 3 ? stoi(argv[3]) : 2000);
+    // Readers register before they start, so the limit must be checked before any thread is created
+    unsigned maxReaders = VersionedTable<LinearHashTable<int, hash1>, int>::MAX_READERS;
+    if (!readerCount || readerCount > maxReaders) {
+        cout << "The reader count must be between 1 and " << maxReaders << endl;
+        return 1;
+    }
+
+    cout << "Loading dataset: " << inputPath << endl;
+    vector<int> data = loadData(inputPath);
+
+    cout << "Profiling " << readerCount << " readers and 1 writer..." << endl;
+    profileConcurrent<LinearHashTable<int, hash1>>(data, readerCount, runTime, "versioned linear probing {h(x)}");
+    profileConcurrent<CuckooTable<int, multiHash, 3>>(data, readerCount, runTime, "versioned cuckoo hashing {3}");
+}
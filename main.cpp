@@ -6,83 +6,67 @@ using std::endl;
 
 // Project-level imports
 #include "BalancedTree.hpp"
+#include "BPlusTree.hpp"
+#include "EytzingerArray.hpp"
 #include "SinglyLinkedList.hpp"
+#include "FlatBucket.hpp"
 #include "VectorList.hpp"
 #include "BucketHashTable.hpp"
 #include "LinearHashTable.hpp"
 #include "CuckooTable.hpp"
+#include "HashFunctions.hpp"
+#include "DataSet.hpp"
+#include "PerfCounters.hpp"
+#include "FilteredContainer.hpp"
 
 // Standard library imports
 #include <fstream>
 #include <sstream>
 #include <vector>
 #include <chrono>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 using namespace std;
 using namespace std::chrono;
 
 const unsigned TABLE_SIZE = 10009;
 const unsigned BATCH_SIZE = 100;
+const unsigned MISS_COUNT = 10000;
+// Number of random draws from the dataset's range before falling back to items outside of it
+const unsigned MISS_ATTEMPTS = MISS_COUNT * 20;
 
-// h(x); modulo is implicitly applied by hash tables
-inline unsigned hash1(int item, unsigned size) {
-    return item;
-}
-
-// h'(x);
-inline unsigned hash2(int item, unsigned size) {
-    return item / size;
-}
-
-// h*(x); added for 3-table cuckoo hashing
-inline unsigned hash3(int item, unsigned size) {
-    return (item | (3 << 10)); // NOLINT(hicpp-signed-bitwise)
-}
-
-// h**(x); added for 4-table cuckoo hashing
-inline unsigned hash4(int item, unsigned size) {
-    return (item | (3 << 8)); // NOLINT(hicpp-signed-bitwise)
-}
-
-// Conditional hashing based on table index
-inline unsigned multiHash(unsigned n, int item, unsigned size) {
-    switch (n + 1) {
-        case 1:
-            return hash1(item, size);
-        case 2:
-            return hash2(item, size);
-        case 3:
-            return hash3(item, size);
-        case 4:
-            return hash4(item, size);
-    }
-    throw runtime_error("Unexpected hash function index");
-}
+// Global output stream for recording data
+ofstream output; // NOLINT(cert-err58-cpp)
+string outputDirectory;
 
-// Load dataset from a given file name
-vector<int> loadData(const string &filename) {
-    vector<int> vec;
-    ifstream input(filename);
-    if (!input.is_open()) {
-        throw runtime_error("Data file not found; check your current working directory");
+// Global hardware performance counters, only opened when requested on the command line
+PerfCounters counters; // NOLINT(cert-err58-cpp)
+// Counts attributed to an empty timed region (the clock reads and counter toggles), per operation
+vector<double> counterOverhead; // NOLINT(cert-err58-cpp)
+const unsigned CALIBRATION_COUNT = 10000;
+
+// Measure the counter overhead of the timing code itself, which is subtracted from every operation
+void calibrateCounters() {
+    counters.reset();
+    for (unsigned i = 0; i < CALIBRATION_COUNT; i++) {
+        // Mirrors the timed region in `timeOperation`, without an operation in between
+        counters.start();
+        high_resolution_clock::now();
+        high_resolution_clock::now();
+        counters.stop();
     }
-
-    string line, token;
-    while (getline(input, line)) {
-        stringstream ss(line);
-        while (getline(ss, token, ',')) {
-            vec.push_back(stoi(token));
+    counterOverhead.clear();
+    for (auto &counter : counters.read()) {
+        if (std::isnan(counter.second)) {
+            cout << "Warning: hardware performance counter could not be scheduled: " << counter.first << endl;
         }
+        counterOverhead.push_back(counter.second / CALIBRATION_COUNT);
     }
-
-    input.close();
-    return vec;
 }
 
-// Global output stream for recording data
-ofstream output; // NOLINT(cert-err58-cpp)
-string outputDirectory;
-
 // Helper method for formatting output file names
 void replaceAll(string &str, const string &from, const string &to) {
     if (from.empty())
@@ -122,9 +106,11 @@ void record(const string &operation, double loadFactor, long long time, unsigned
     output << operation << "," << loadFactor << "," << time << "," << resizeCount << endl;
 }
 
-// Time a specific operation and ensure correctness
+// Time a specific operation and ensure correctness; `occupied` is the number of elements held by the table
+// throughout the phase, or negative if the occupancy follows the position in `data`
 template<class U, bool P(Container<U> &, U, bool), unsigned B>
-void timeOperation(const vector<U> &data, vector<U> dupes, Container<U> &table, const string &label) {
+void timeOperation(const vector<U> &data, vector<U> dupes, Container<U> &table, const string &label,
+                   long long occupied = -1) {
     cout << "* " << label << ": ";
 
     // Only iterate elements up to a multiple of the provided batch size
@@ -137,6 +123,7 @@ void timeOperation(const vector<U> &data, vector<U> dupes, Container<U> &table,
     unsigned batchCount = 0;
     unsigned resizeCount = 0;
     unsigned prevSize = table.capacity();
+    counters.reset();
     while (index < size) {
         unsigned batchTime = 0;
         for (unsigned i = 0; i < B; i++) {
@@ -158,14 +145,17 @@ void timeOperation(const vector<U> &data, vector<U> dupes, Container<U> &table,
                 }
             }
 
-            // Compute the load factor based on the current index and duplicate cache
+            // Compute the load factor based on the current index and duplicate cache, unless the occupancy is fixed
             unsigned capacity = table.capacity();
-            double loadFactor = capacity ? (double) (index - used.size()) / capacity : 0;
+            double count = occupied < 0 ? (double) (index - used.size()) : (double) occupied;
+            double loadFactor = capacity ? count / capacity : 0;
 
-            // Time the current operation
+            // Time the current operation; counters only run for the timed region, whose own overhead is calibrated
+            counters.start();
             auto start = high_resolution_clock::now();
             bool result = P(table, item, duplicate);
             auto stop = high_resolution_clock::now();
+            counters.stop();
 
             // Calculate the precise execution time
             auto duration = duration_cast<nanoseconds>(stop - start);
@@ -200,6 +190,23 @@ void timeOperation(const vector<U> &data, vector<U> dupes, Container<U> &table,
         cout << " (resizes: " << resizeCount << ")";
     }
     cout << endl;
+
+    // Display the average hardware counter values per loop iteration, excluding the timing overhead
+    if (counters.available()) {
+        cout << " ";
+        auto values = counters.read();
+        for (unsigned i = 0; i < values.size(); i++) {
+            cout << " " << values[i].first << ": ";
+            if (std::isnan(values[i].second)) {
+                // The counter never got onto the PMU (e.g. because other events held every hardware counter)
+                cout << "not counted";
+                continue;
+            }
+            double overhead = i < counterOverhead.size() && !std::isnan(counterOverhead[i]) ? counterOverhead[i] : 0;
+            cout << max(0.0, values[i].second / (batchCount * B) - overhead);
+        }
+        cout << endl;
+    }
 }
 
 // Returns true if the insertion result matches whether the item has been added before
@@ -214,41 +221,104 @@ bool doContains(Container<U> &t, U item, bool duplicate) {
     return t.contains(item);
 }
 
+// Returns true if the item is not contained in the table; used for items known to be absent
+template<class U>
+bool doMiss(Container<U> &t, U item, bool duplicate) {
+    return !t.contains(item);
+}
+
 // Returns true if the deletion result matches whether the item has been removed before
 template<class U>
 bool doRemove(Container<U> &t, U item, bool duplicate) {
     return t.remove(item) != duplicate;
 }
 
-// Profiles a specific container
+// Profiles a specific container, including lookups of absent items if any are provided
 template<class U>
-void profile(const vector<U> &data, const vector<U> &dupes, Container<U> &table, const string &label) {
+void profile(const vector<U> &data, const vector<U> &dupes, Container<U> &table, const string &label,
+             const vector<U> &misses = vector<U>()) {
     cout << endl;
     cout << "[" << label << "]" << endl;
     startRecording(label);
     timeOperation<U, doInsert, BATCH_SIZE>(data, dupes, table, "insert");
     timeOperation<U, doContains, BATCH_SIZE>(data, dupes, table, "contains");
+    if (!misses.empty()) {
+        // The table holds every distinct element of the dataset while absent items are looked up
+        vector<U> elements(data);
+        sort(elements.begin(), elements.end());
+        long long occupied = unique(elements.begin(), elements.end()) - elements.begin();
+        timeOperation<U, doMiss, BATCH_SIZE>(misses, vector<U>(), table, "miss", occupied);
+    }
     timeOperation<U, doRemove, BATCH_SIZE>(data, dupes, table, "remove");
     stopRecording();
 }
 
 // Profiles all tables which require a single hash function
 template<class U, unsigned H(U, unsigned)>
-void profileSingleHashFunction(const vector<U> &data, const vector<U> &dupes, const string &label) {
+void profileSingleHashFunction(const vector<U> &data, const vector<U> &dupes, const vector<U> &misses,
+                               const string &label) {
     {
         BucketHashTable<SinglyLinkedList<U>, U, H, TABLE_SIZE> table;
-        profile(data, dupes, table, "linked list {" + label + "}");
+        profile(data, dupes, table, "linked list {" + label + "}", misses);
+    }
+    {
+        BucketHashTable<SinglyLinkedList<U>, U, H, TABLE_SIZE> table;
+        FilteredContainer<U> filtered(table, data.size());
+        profile(data, dupes, filtered, "filtered linked list {" + label + "}", misses);
+    }
+    {
+        BucketHashTable<FlatBucket<U>, U, H, TABLE_SIZE> table;
+        profile(data, dupes, table, "flat bucket {" + label + "}");
     }
     {
         BucketHashTable<BalancedTree<U>, U, H, TABLE_SIZE> table;
         profile(data, dupes, table, "binary tree {" + label + "}");
     }
+    {
+        BucketHashTable<BPlusTree<U>, U, H, TABLE_SIZE> table;
+        profile(data, dupes, table, "b+ tree {" + label + "}");
+    }
+    {
+        LinearHashTable<U, H> table(TABLE_SIZE);
+        profile(data, dupes, table, "linear probing {" + label + "}", misses);
+    }
     {
         LinearHashTable<U, H> table(TABLE_SIZE);
-        profile(data, dupes, table, "linear probing {" + label + "}");
+        FilteredContainer<U> filtered(table, data.size());
+        profile(data, dupes, filtered, "filtered linear probing {" + label + "}", misses);
     }
 }
 
+// Reports the false positive rate, overflow scan rate and memory overhead of a cuckoo filter holding the full dataset
+template<class U>
+void profileFilter(const vector<U> &data, const vector<U> &misses) {
+    if (misses.empty()) {
+        return;
+    }
+    cout << endl;
+    cout << "[cuckoo filter]" << endl;
+    vector<U> elements(data);
+    sort(elements.begin(), elements.end());
+    elements.erase(unique(elements.begin(), elements.end()), elements.end());
+    CuckooFilter<U> filter(elements.size());
+    for (U x : elements) {
+        filter.insert(x);
+    }
+    unsigned falsePositives = 0;
+    unsigned overflowScans = 0;
+    for (U x : misses) {
+        falsePositives += filter.contains(x);
+        overflowScans += filter.overflowing(x);
+    }
+    cout << "* false positive rate: " << 100.0 * falsePositives / misses.size() << "% ("
+         << falsePositives << " of " << misses.size() << ")" << endl;
+    cout << "* overflow scan rate: " << 100.0 * overflowScans / misses.size() << "% ("
+         << overflowScans << " of " << misses.size() << ")" << endl;
+    cout << "* memory: " << filter.memoryUsage() << " bytes ("
+         << 8.0 * filter.memoryUsage() / elements.size() << " bits per element, overflowing: "
+         << filter.overflowSize() << ", saturated blocks: " << filter.saturatedBlocks() << ")" << endl;
+}
+
 // Profiles all tables which require multiple or indexed hash functions
 template<class U, unsigned H(unsigned, U, unsigned), unsigned N>
 void profileMultiHashFunction(const vector<U> &data, const vector<U> &dupes, const string &label) {
@@ -258,11 +328,49 @@ void profileMultiHashFunction(const vector<U> &data, const vector<U> &dupes, con
     }
 }
 
+// Generate items which are absent from the dataset, drawn from the same range as the dataset where possible
+vector<int> generateMisses(const vector<int> &data) {
+    vector<int> misses;
+    if (data.empty()) {
+        return misses;
+    }
+    vector<int> sorted(data);
+    sort(sorted.begin(), sorted.end());
+    mt19937 generator(2270);
+    uniform_int_distribution<int> distribution(sorted.front(), sorted.back());
+    for (unsigned attempt = 0; attempt < MISS_ATTEMPTS && misses.size() < MISS_COUNT; attempt++) {
+        int item = distribution(generator);
+        if (!binary_search(sorted.begin(), sorted.end(), item)) {
+            misses.push_back(item);
+        }
+    }
+    // A densely filled range has too few gaps, so continue with items above and then below the dataset
+    for (int item = sorted.back(); misses.size() < MISS_COUNT && item < numeric_limits<int>::max();) {
+        misses.push_back(++item);
+    }
+    for (int item = sorted.front(); misses.size() < MISS_COUNT && item > numeric_limits<int>::min();) {
+        misses.push_back(--item);
+    }
+    return misses;
+}
+
 int main(int argc, char **argv) {
     // Retrieve dataset file path from first command line argument
     string inputPath = argc > 1 ? argv[1] : "data/dataSetC.csv";
     // Set global output directory from second command line argument
     outputDirectory = argc > 2 ? argv[2] : "output";
+    // Enable hardware performance counters with a third `--counters` argument
+    if (argc > 3 && string(argv[3]) == "--counters") {
+        vector<string> missing = counters.open();
+        if (!counters.available()) {
+            cout << "Warning: hardware performance counters are unavailable; check perf_event_paranoid" << endl;
+        } else {
+            for (const string &name : missing) {
+                cout << "Warning: hardware performance counter unavailable: " << name << endl;
+            }
+            calibrateCounters();
+        }
+    }
 
     cout << "Loading dataset: " << inputPath << endl;
     vector<int> data = loadData(inputPath);
@@ -293,6 +401,9 @@ int main(int argc, char **argv) {
     cout << endl;
     dupes.shrink_to_fit();
 
+    cout << "Generating absent items for negative lookups..." << endl;
+    vector<int> misses = generateMisses(data);
+
     cout << "Profiling containers..." << endl;
 
     // Define an alternate duplicate vector for containers which store duplicate elements
@@ -303,6 +414,14 @@ int main(int argc, char **argv) {
         BalancedTree<int> tree;
         profile(data, dupes, tree, "baseline: balanced tree");
     }
+    {
+        BPlusTree<int> tree;
+        profile(data, dupes, tree, "baseline: b+ tree");
+    }
+    {
+        EytzingerArray<int> array;
+        profile(data, dupes, array, "baseline: eytzinger array");
+    }
     {
         SinglyLinkedList<int> list;
         profile(data, allowDupes, list, "baseline: linked list");
@@ -313,11 +432,13 @@ int main(int argc, char **argv) {
     }
 
     // Templates are used here for clarity and to allow additional compile-time optimizations
-    profileSingleHashFunction<int, hash1>(data, dupes, "h(x)");
-    profileSingleHashFunction<int, hash2>(data, dupes, "h'(x)");
-    profileSingleHashFunction<int, hash3>(data, dupes, "h*(x)");
+    profileSingleHashFunction<int, hash1>(data, dupes, misses, "h(x)");
+    profileSingleHashFunction<int, hash2>(data, dupes, misses, "h'(x)");
+    profileSingleHashFunction<int, hash3>(data, dupes, misses, "h*(x)");
 
     // Using 3 hash functions improves the cuckoo table load factor from 50% to 90%
     profileMultiHashFunction<int, multiHash, 3>(data, dupes, "3");
     profileMultiHashFunction<int, multiHash, 4>(data, dupes, "4");
+
+    profileFilter(data, misses);
 }
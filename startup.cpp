@@ -0,0 +1,108 @@
+// Global imports
+#include <iostream>
+
+using std::cout;
+using std::endl;
+
+// Project-level imports
+#include "LinearHashTable.hpp"
+#include "CuckooTable.hpp"
+#include "HashFunctions.hpp"
+#include "DataSet.hpp"
+
+// Standard library imports
+#include <algorithm>
+#include <vector>
+#include <chrono>
+
+using namespace std;
+using namespace std::chrono;
+
+const unsigned TABLE_SIZE = 10009;
+const unsigned REPETITIONS = 7;
+
+// Returns the median of a set of timings
+long long median(vector<long long> times) {
+    sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+// Time a startup procedure several times and return the median duration in microseconds
+template<class F>
+long long timeStartup(F procedure) {
+    vector<long long> times;
+    for (unsigned r = 0; r < REPETITIONS; r++) {
+        auto start = high_resolution_clock::now();
+        procedure();
+        auto stop = high_resolution_clock::now();
+        times.push_back(duration_cast<microseconds>(stop - start).count());
+    }
+    return median(times);
+}
+
+// Ensure that a table answers `contains` for every element of the dataset
+template<class T>
+void verify(const T &table, const vector<int> &data, const string &label) {
+    for (int x : data) {
+        if (!table.contains(x)) {
+            cout << ">> unexpected (" << label << "): " << x << endl;
+            return;
+        }
+    }
+}
+
+// Compares rebuilding a table from the dataset with mapping a previously saved snapshot
+template<class T>
+void profileStartup(const string &inputPath, const string &snapshotPath, const string &label) {
+    cout << endl;
+    cout << "[" << label << "]" << endl;
+
+    vector<int> data = loadData(inputPath);
+    {
+        T table(TABLE_SIZE);
+        for (int x : data) {
+            table.insert(x);
+        }
+        table.save(snapshotPath);
+    }
+
+    // Each procedure ends with a lookup so that the first page of the table is actually touched
+    long long rebuildTime = timeStartup([&]() {
+        T table(TABLE_SIZE);
+        for (int x : loadData(inputPath)) {
+            table.insert(x);
+        }
+        verify(table, {data[0]}, label);
+    });
+    long long verifiedTime = timeStartup([&]() {
+        T table(1);
+        table.load(snapshotPath);
+        verify(table, {data[0]}, label);
+    });
+    long long mappedTime = timeStartup([&]() {
+        T table(1);
+        table.load(snapshotPath, false);
+        verify(table, {data[0]}, label);
+    });
+
+    T table(1);
+    table.load(snapshotPath);
+    verify(table, data, label);
+
+    cout << "* rebuild from csv: " << rebuildTime << " us" << endl;
+    cout << "* map snapshot (checksum): " << verifiedTime << " us" << endl;
+    cout << "* map snapshot: " << mappedTime << " us" << endl;
+}
+
+int main(int argc, char **argv) {
+    // Retrieve dataset file path from first command line argument
+    string inputPath = argc > 1 ? argv[1] : "data/dataSetC.csv";
+    // Set snapshot directory from second command line argument
+    string snapshotDirectory = argc > 2 ? argv[2] : ".";
+
+    cout << "Profiling startup: " << inputPath << endl;
+    profileStartup<LinearHashTable<int, hash1>>(inputPath, snapshotDirectory + "/linear_probing_hx.snap",
+                                                "linear probing {h(x)}");
+    profileStartup<CuckooTable<int, multiHash, 3>>(inputPath, snapshotDirectory + "/cuckoo_hashing_3.snap",
+                                                   "cuckoo hashing {3}");
+}